@@ -25,6 +25,8 @@ public:
 	glm::vec3 Min() const { return m_min; }
 
 	Ray::HitType Hit(const Ray& ray, Ray::time_t minTime, Ray::time_t maxTime, HitRecord& record) const;
+	// Test slabow bez rozgalezien (SSE), na odwrotnosci kierunku z Ray; wynik jak w Hit
+	Ray::HitType HitSlab(const Ray& ray, Ray::time_t minTime, Ray::time_t maxTime, HitRecord& record) const;
 
 private:
 	glm::vec3 m_min{ std::numeric_limits<float>::max() };
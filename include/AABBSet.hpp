@@ -0,0 +1,57 @@
+#pragma once
+#include "AABB.hpp"
+#include "Ray.hpp"
+
+#include <glm/glm.hpp>
+
+#include <array>
+#include <cstdint>
+#include <vector>
+
+// Do s_size promieni w ukladzie SoA, testowane razem przeciw jednemu pudelku
+class RayPacket {
+public:
+	static constexpr size_t s_size = 8;
+
+	// Zwraca false, gdy pakiet jest juz pelny
+	bool Add(const Ray& ray);
+	void Clear() { m_count = 0; }
+	size_t Size() const { return m_count; }
+
+private:
+	friend class AABBSet;
+
+	std::array<std::array<float, s_size>, 3> m_origin{};
+	std::array<std::array<float, s_size>, 3> m_direction{};
+	std::array<std::array<float, s_size>, 3> m_inverseDirection{};
+	std::array<uint8_t, s_size> m_signMask{};
+	size_t m_count{ 0 };
+};
+
+// Zbior pudelek w ukladzie SoA (osobne tablice min/max per os), testowany blokami
+class AABBSet {
+public:
+	static constexpr size_t s_batch = 8;
+	using Records = std::array<AABB::HitRecord, s_batch>;
+
+	size_t Add(const AABB& box);
+	void Clear();
+	size_t Size() const { return m_count; }
+	AABB Get(size_t index) const;
+
+	// Promien kontra pudelka [first, first + s_batch); bit i maski to trafienie first + i,
+	// records[i] wypelniony jak przez AABB::Hit
+	uint32_t HitBatch(const Ray& ray, size_t first, Ray::time_t minTime, Ray::time_t maxTime, Records& records) const;
+	// Najblizsze trafione pudelko z calego zbioru
+	Ray::HitType Hit(const Ray& ray, Ray::time_t minTime, Ray::time_t maxTime, AABB::HitRecord& record, size_t& index) const;
+
+	// Pakiet promieni kontra jedno pudelko; bit i maski to trafienie promienia i
+	static uint32_t HitPacket(const AABB& box, const RayPacket& packet, Ray::time_t minTime, Ray::time_t maxTime, Records& records);
+
+private:
+	// Tablice sa dopelniane do wielokrotnosci s_batch plus s_batch - 1 pudelek,
+	// wiec odczyt czterech torow od kazdego first < m_count miesci sie w nich
+	std::array<std::vector<float>, 3> m_min;
+	std::array<std::vector<float>, 3> m_max;
+	size_t m_count{ 0 };
+};
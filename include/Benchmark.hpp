@@ -0,0 +1,20 @@
+#pragma once
+
+#include <string>
+
+// Benchmarki uruchamiane z linii polecen: app --bench <nazwa>
+class Benchmark {
+public:
+  // Runs the named benchmark ("all" runs every one); returns the exit code.
+  static int Run(const std::string &name);
+
+private:
+  static void Visibility();
+  static void Storage();
+  static void Raycast();
+  static void Slab();
+  static void Batch();
+  static void Walk();
+  static void Directory();
+  static void Sections();
+};
@@ -0,0 +1,39 @@
+#pragma once
+#include "../include/Cube.hpp"
+
+#include <cstdint>
+#include <vector>
+
+// Typy kostek jako indeksy do lokalnej palety, upakowane po 0..16 bitow.
+// Chunk z jednym typem nie trzyma zadnych indeksow (0 bitow na kostke).
+class BlockStorage {
+public:
+  explicit BlockStorage(size_t size, Cube::Type fill = Cube::Type::None);
+
+  Cube::Type Get(size_t index) const;
+  void Set(size_t index, Cube::Type type);
+  // Sets every block to one type and drops the packed indices.
+  void Fill(Cube::Type type);
+  // Drops unused palette entries and repacks with the narrowest index width.
+  void Compact();
+
+  size_t Size() const { return m_size; }
+  size_t PaletteSize() const;
+  unsigned BitsPerBlock() const { return m_bits; }
+  // Heap bytes held by the palette and packed indices.
+  size_t MemoryUsage() const;
+
+private:
+  uint32_t Index(size_t index) const;
+  void SetIndex(size_t index, uint32_t paletteIndex);
+  uint32_t FindOrAdd(Cube::Type type);
+  void Repack(unsigned bits);
+
+  size_t m_size;
+  unsigned m_bits{0};
+  std::vector<uint64_t> m_words;
+
+  // Wpisy palety z licznikiem uzyc; wolne sloty (licznik 0) sa uzywane ponownie
+  std::vector<Cube::Type> m_palette;
+  std::vector<uint32_t> m_counts;
+};
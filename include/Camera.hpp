@@ -12,6 +12,12 @@ public:
   glm::vec3 Front() const { return m_front; }
   glm::mat4 View() const { return m_lookAt; }
   glm::mat4 Projection() const { return m_projection; }
+  float Yaw() const { return m_yaw; }
+  float Pitch() const { return m_pitch; }
+
+  // Ustawia pozycje i kierunek naraz (np. odtwarzanie sciezki kamery)
+  void SetPose(const glm::vec3 &position, float yaw, float pitch);
+  void SetAspectRatio(float aspectRatio);
 
   void Rotate(const sf::Vector2i &mouseDelta);
   void MoveForward(float dt);
@@ -0,0 +1,35 @@
+#pragma once
+#include "../include/Camera.hpp"
+
+#include <glad/glad.h>
+#include <glm/glm.hpp>
+
+// Dane kamery dla wszystkich programow: jeden UBO (std140) zapisywany raz na
+// klatke i podpiety na stalym punkcie wiazania
+class CameraBuffer {
+public:
+  static constexpr GLuint s_bindingPoint = 0;
+  // Nazwa bloku uniformow w shaderach, wiazanego przez ShaderProgram
+  static constexpr const char *s_blockName = "Camera";
+
+  // Uklad std140: mat4 to cztery kolumny vec4, pozycja dopelniona do vec4
+  struct Data {
+    glm::mat4 m_view;
+    glm::mat4 m_projection;
+    glm::mat4 m_viewProjection;
+    glm::vec4 m_position;
+  };
+
+  CameraBuffer();
+  CameraBuffer(const CameraBuffer &) = delete;
+  CameraBuffer &operator=(const CameraBuffer &) = delete;
+  CameraBuffer(CameraBuffer &&) noexcept;
+  CameraBuffer &operator=(CameraBuffer &&) noexcept;
+  ~CameraBuffer();
+
+  // Orphans the previous storage, so a frame still in flight keeps its copy.
+  void Update(const Camera &camera);
+
+private:
+  GLuint m_ubo{0};
+};
@@ -0,0 +1,38 @@
+#pragma once
+#include "../include/Camera.hpp"
+
+#include <glm/glm.hpp>
+
+#include <optional>
+#include <string>
+#include <vector>
+
+// Sciezka kamery: klatki kluczowe (czas, pozycja, yaw, pitch) interpolowane
+// liniowo. Plik tekstowy ma jedna klatke na linie: "t x y z yaw pitch".
+class CameraPath {
+public:
+  struct Key {
+    float m_time;
+    glm::vec3 m_position;
+    float m_yaw;
+    float m_pitch;
+  };
+
+  // Okrazenie wokol center na wysokosci height, kamera patrzy do srodka
+  static CameraPath Orbit(const glm::vec3 &center, float radius, float height,
+                          float duration);
+  static std::optional<CameraPath> Load(const std::string &path);
+  bool Save(const std::string &path) const;
+
+  // Klatki musza przychodzic z rosnacym czasem
+  void Add(float time, const Camera &camera);
+  void Clear() { m_keys.clear(); }
+
+  // Ustawia kamere na pozycje z chwili time (przycinane do [0, Duration()])
+  void Apply(float time, Camera &camera) const;
+  float Duration() const;
+  bool Empty() const { return m_keys.empty(); }
+
+private:
+  std::vector<Key> m_keys;
+};
@@ -1,4 +1,7 @@
 #pragma once
+#include "../include/BlockStorage.hpp"
+#include "../include/ChunkInstances.hpp"
+#include "../include/ChunkMesh.hpp"
 #include "../include/Cube.hpp"
 #include "../include/CubePalette.hpp"
 #include "../include/ShaderProgram.hpp"
@@ -10,17 +13,56 @@
 #include <glm/gtc/matrix_transform.hpp>
 
 #include <array>
+#include <cstdint>
+#include <type_traits>
 
-template <uint8_t Depth, uint8_t Width, uint8_t Height>
+template <uint8_t Depth, uint8_t Width, uint16_t Height>
 class Chunk {
-  struct CubeData {
-    Cube::Type m_type{Cube::Type::None};
-    bool m_isVisible{true};
-  };
+  static_assert(Depth <= 64, "Occupancy row along depth must fit in 64 bits");
+  static_assert(Width <= 64, "Border slice along width must fit in 64 bits");
+
+  // Kostki sa trzymane w sekcjach po 16 warstw; sekcja jednego typu (albo
+  // pusta) nie trzyma indeksow i jest pomijana przez przejscia po chunk'u
+  static constexpr size_t s_sectionHeight = 16;
+  static constexpr size_t s_sectionCount = Height / s_sectionHeight;
+  static_assert(Height % s_sectionHeight == 0 && Height <= 256,
+                "Height must be a multiple of the section height, up to 256");
 
-  using FlattenData_t = std::array<CubeData, Depth * Width * Height>;
+  // Rzad kostek wzdluz z (dla ustalonych x, y) jako bity, bit z = kostka z
+  using Row_t = std::conditional_t<
+      (Depth <= 8), uint8_t,
+      std::conditional_t<(Depth <= 16), uint16_t,
+                         std::conditional_t<(Depth <= 32), uint32_t, uint64_t>>>;
+  using Rows_t = std::array<Row_t, Width * Height>;
+  static constexpr Row_t s_fullRow =
+      Depth == 64 ? ~Row_t(0) : static_cast<Row_t>((uint64_t(1) << Depth) - 1);
+
+  // Piramida zajetosci: cegly 2^3, 4^3 i 8^3 kostek (poziomy 1..3)
+  static constexpr int s_brickLevels = 3;
+  static_assert((size_t(1) << s_brickLevels) <= s_sectionHeight,
+                "Bricks must not cross sections");
+  enum BrickState : uint8_t {
+    Empty = 0, // max = 0
+    Mixed = 1,
+    Full = 3   // min = 1
+  };
+  static constexpr size_t BricksAlong(size_t size, int level) {
+    return (size + (size_t(1) << level) - 1) >> level;
+  }
+  static constexpr size_t BrickCount(int level) {
+    return BricksAlong(Depth, level) * BricksAlong(Width, level) *
+           BricksAlong(Height, level);
+  }
+  // Poczatek kazdego poziomu w m_pyramid (poziom 0 to same kostki, nie jest trzymany)
+  static constexpr std::array<size_t, s_brickLevels + 2> s_brickOffsets = {
+      0, 0, BrickCount(1), BrickCount(1) + BrickCount(2),
+      BrickCount(1) + BrickCount(2) + BrickCount(3)};
+  using Pyramid_t = std::array<uint8_t, s_brickOffsets[s_brickLevels + 1]>;
 
 public:
+  // Rysowanie zbudowanej geometrii albo calych kostek jako instancji
+  enum class DrawPath { Mesh, Instanced };
+
   struct HitRecord {
     glm::ivec3 m_cubeIndex;
     glm::ivec3 m_neighbourIndex;
@@ -29,17 +71,103 @@ public:
   Chunk(const glm::vec2 &origin, CubePalette &palette);
 
   void Generate(); // Bez PerlinNoise
+  // Przenosi chunk (np. slot okna World) w nowe miejsce; potem Generate.
+  // Bufory GL i pamiec kostek sa uzywane ponownie.
+  void MoveTo(const glm::vec2 &origin);
   void Draw(ShaderProgram &shader) const;
+  // Buduje geometrie odslonietych scian (bez wysylania na GPU)
+  void BuildMesh(ChunkMesh &mesh, ChunkMesh::Mode mode) const;
+  void SetMeshMode(ChunkMesh::Mode mode);
+  ChunkMesh::Mode MeshMode() const { return m_meshMode; }
+  // Przesuniecia kostek z co najmniej jedna odslonieta sciana
+  void BuildInstances(ChunkInstances &instances) const;
+  void SetDrawPath(DrawPath path) { m_drawPath = path; }
+  DrawPath GetDrawPath() const { return m_drawPath; }
 
   Ray::HitType Hit(const Ray &ray, Ray::time_t min, Ray::time_t max, HitRecord &record) const;
   bool RemoveBlock(uint8_t width, uint8_t height, uint8_t depth);
 
+  // Pelne przeliczenie masek scian calego chunk'a
+  void UpdateVisibility();
+  // Przelicza tylko podana kostke i jej sasiadow; zwraca, czy maski sie zmienily
+  bool UpdateVisibility(size_t depth, size_t width, size_t height);
+  // Kopiuje brzeg sasiada lezacego po stronie side (Front, Back, Left albo
+  // Right) i przelicza tylko sciany tej strony; nullptr: brak sasiada, brzeg
+  // odsloniety. Po zmianie kostek na brzegu sasiad musi byc podany ponownie
+  // (albo jego kostka przez UpdateBorder).
+  // Zwraca, czy maski sie zmienily.
+  bool SetNeighbour(Cube::Face side, const Chunk *neighbour);
+  // Po zmianie jednej kostki na brzegu sasiada: odswieza tylko jej komorke
+  // brzegu side i jeden rzad scian. column to z dla Left i Right, x dla Front
+  // i Back. Zwraca, czy maski sie zmienily.
+  bool UpdateBorder(Cube::Face side, const Chunk *neighbour, size_t column,
+                    size_t height);
+  // Czy kostka lezy na brzegu od strony side
+  static bool OnBorder(Cube::Face side, size_t depth, size_t width);
+
+  Cube::Type GetType(size_t depth, size_t width, size_t height) const;
+
+  enum class SectionState {
+    Empty,   // Same None
+    Uniform, // Jeden typ kostek
+    Mixed
+  };
+  static constexpr size_t SectionCount() { return s_sectionCount; }
+  SectionState GetSectionState(size_t section) const;
+
+  const AABB &Bounds() const { return m_aabb; }
+  // Bytes held by the chunk, including its packed block storage.
+  size_t MemoryUsage() const;
+
 private:
+  // Indeks kostki w jej sekcji
   size_t CoordsToIndex(size_t depth, size_t width, size_t height) const;
-  void UpdateVisibility();
+  size_t RowIndex(size_t width, size_t height) const { return height * Width + width; }
+  // Poza chunk'iem rzad jest pusty
+  Row_t OccupancyRow(int width, int height) const;
+  // Zajetosc komorek, na ktore patrzy sciana face kostek rzedu, z brzegiem
+  // sasiedniego chunk'a
+  Row_t NeighbourRow(Cube::Face face, int width, int height) const;
+  bool UpdateRowFaces(size_t width, size_t height);
+  // Zapisuje maske sciany rzedu i zaznacza ja w sekcji; zwraca, czy sie zmienila
+  bool SetRowFaces(size_t face, size_t width, size_t height, Row_t faces);
+  // Zajete komorki brzegu side w warstwie height: dla Left i Right rzad wzdluz
+  // z, dla Front i Back bity wzdluz x
+  uint64_t BorderSlice(Cube::Face side, size_t height) const;
+  void SetBlock(size_t depth, size_t width, size_t height, Cube::Type type);
+  // Indeks cegly poziomu level zawierajacej podana kostke
+  size_t BrickIndex(int level, size_t depth, size_t width, size_t height) const;
+  void UpdateBrick(int level, size_t depth, size_t width, size_t height);
+  void UpdatePyramid();
+  void UpdatePyramid(size_t depth, size_t width, size_t height);
+  bool IsSolid(int depth, int width, int height) const;
+  void BuildFaces(ChunkMesh &mesh) const;
+  void BuildGreedy(ChunkMesh &mesh) const;
+
+  struct Section {
+    BlockStorage m_blocks{size_t(Depth) * Width * s_sectionHeight};
+    // Sciany (Cube::FaceBit), ktore moga byc odsloniete w sekcji; czyszczone
+    // tylko przy pelnym przeliczeniu widocznosci
+    uint8_t m_exposed{0};
+  };
 
   CubePalette &m_palette;
-  FlattenData_t m_data;
+  std::array<Section, s_sectionCount> m_sections;
+  Rows_t m_occupancy{};
+  // Odsloniete sciany per kierunek (Cube::Face), w tym samym ukladzie rzedow
+  std::array<Rows_t, Cube::s_faceCount> m_faces{};
+  // Brzegi sasiadow (BorderSlice ich przeciwnej strony) per Front..Right
+  static constexpr size_t s_sideCount = 4;
+  std::array<std::array<uint64_t, Height>, s_sideCount> m_borders{};
+  Pyramid_t m_pyramid{};
   glm::vec2 m_origin;
   AABB m_aabb;
+
+  // Przebudowywany leniwie w Draw, tylko gdy dane chunk'a sie zmienily
+  mutable ChunkMesh m_mesh;
+  mutable bool m_meshDirty{true};
+  ChunkMesh::Mode m_meshMode{ChunkMesh::Mode::Faces};
+  mutable ChunkInstances m_instances;
+  mutable bool m_instancesDirty{true};
+  DrawPath m_drawPath{DrawPath::Mesh};
 };
\ No newline at end of file
@@ -0,0 +1,172 @@
+#pragma once
+#include "../include/Epoch.hpp"
+
+#include <glm/glm.hpp>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+// Mapa klucz chunk'a -> chunk dla wielu watkow. Odczyt nie bierze blokad:
+// shard trzyma wskaznik na niezmienna, posortowana tablice wpisow, czytana
+// w sekcji Epoch::Guard. Zapis kopiuje tablice jednego sharda pod jego
+// mutexem, podmienia wskaznik i oddaje stara tablice do Epoch::Retire.
+// Usuniecie nie uniewaznia chunk'a, ktory czytelnik trzyma przez shared_ptr.
+template <typename T> class ChunkDirectory {
+public:
+  using Key = glm::ivec2;
+  static constexpr size_t s_shardCount = 16;
+
+  ChunkDirectory() = default;
+  ChunkDirectory(const ChunkDirectory &) = delete;
+  ChunkDirectory &operator=(const ChunkDirectory &) = delete;
+
+  // Nikt nie moze juz czytac: tablice sa usuwane od razu
+  ~ChunkDirectory() {
+    for (Shard &shard : m_shards) {
+      delete shard.m_table.load();
+    }
+  }
+
+  // nullptr, gdy klucza nie ma
+  std::shared_ptr<T> Find(const Key &key) const {
+    Epoch::Guard guard;
+    const Entry *entry = Lookup(key);
+    return entry != nullptr ? entry->m_value : nullptr;
+  }
+
+  // visit(const T &) w sekcji odczytu, bez kopiowania shared_ptr (licznik
+  // referencji wspoldzielony miedzy watkami); zwraca false, gdy klucza nie ma
+  template <typename Visit> bool Read(const Key &key, Visit &&visit) const {
+    Epoch::Guard guard;
+    const Entry *entry = Lookup(key);
+    if (entry == nullptr) {
+      return false;
+    }
+    visit(static_cast<const T &>(*entry->m_value));
+    return true;
+  }
+
+  bool Contains(const Key &key) const {
+    Epoch::Guard guard;
+    return Lookup(key) != nullptr;
+  }
+
+  // Wstawia albo podmienia wartosc klucza
+  void Insert(const Key &key, std::shared_ptr<T> value) {
+    Shard &shard = ShardOf(key);
+    std::lock_guard<std::mutex> lock(shard.m_mutex);
+    const Table *current = shard.m_table.load();
+    auto table = current != nullptr ? std::make_unique<Table>(*current)
+                                    : std::make_unique<Table>();
+    const uint64_t packed = Pack(key);
+    auto position = LowerBound(*table, packed);
+    if (position != table->end() && position->m_packed == packed) {
+      position->m_value = std::move(value);
+    } else {
+      table->insert(position, {packed, key, std::move(value)});
+      m_size.fetch_add(1, std::memory_order_relaxed);
+    }
+    Publish(shard, std::move(table));
+  }
+
+  // Zwraca usuniety chunk (nullptr, gdy klucza nie bylo)
+  std::shared_ptr<T> Erase(const Key &key) {
+    Shard &shard = ShardOf(key);
+    std::lock_guard<std::mutex> lock(shard.m_mutex);
+    const Table *current = shard.m_table.load();
+    if (current == nullptr) {
+      return nullptr;
+    }
+    const uint64_t packed = Pack(key);
+    const auto found = LowerBound(*current, packed);
+    if (found == current->end() || found->m_packed != packed) {
+      return nullptr;
+    }
+    std::shared_ptr<T> removed = found->m_value;
+    auto table = std::make_unique<Table>();
+    table->reserve(current->size() - 1);
+    table->insert(table->end(), current->begin(), found);
+    table->insert(table->end(), found + 1, current->end());
+    m_size.fetch_sub(1, std::memory_order_relaxed);
+    Publish(shard, std::move(table));
+    return removed;
+  }
+
+  // visit(key, const std::shared_ptr<T> &) dla migawki kazdego sharda
+  template <typename Visit> void ForEach(Visit &&visit) const {
+    Epoch::Guard guard;
+    for (const Shard &shard : m_shards) {
+      if (const Table *table = shard.m_table.load()) {
+        for (const Entry &entry : *table) {
+          visit(entry.m_key, entry.m_value);
+        }
+      }
+    }
+  }
+
+  size_t Size() const { return m_size.load(std::memory_order_relaxed); }
+
+private:
+  struct Entry {
+    uint64_t m_packed;
+    Key m_key;
+    std::shared_ptr<T> m_value;
+  };
+  using Table = std::vector<Entry>;
+
+  // Shard na wlasnej linii cache, zeby pisarze roznych shardow sie nie
+  // przepychali
+  struct alignas(64) Shard {
+    std::mutex m_mutex;
+    std::atomic<const Table *> m_table{nullptr};
+  };
+
+  static uint64_t Pack(const Key &key) {
+    return (uint64_t(uint32_t(key.x)) << 32) | uint32_t(key.y);
+  }
+
+  Shard &ShardOf(const Key &key) { return m_shards[ShardIndex(key)]; }
+  const Shard &ShardOf(const Key &key) const {
+    return m_shards[ShardIndex(key)];
+  }
+  static size_t ShardIndex(const Key &key) {
+    // Sasiednie chunk'i trafiaja do roznych shardow
+    return (uint32_t(key.x) * 73856093u ^ uint32_t(key.y) * 19349663u) %
+           s_shardCount;
+  }
+
+  template <typename Table_t>
+  static auto LowerBound(Table_t &table, uint64_t packed) {
+    return std::lower_bound(
+        table.begin(), table.end(), packed,
+        [](const Entry &entry, uint64_t value) { return entry.m_packed < value; });
+  }
+
+  // Wymaga Epoch::Guard w watku wywolujacym
+  const Entry *Lookup(const Key &key) const {
+    const Table *table = ShardOf(key).m_table.load();
+    if (table == nullptr) {
+      return nullptr;
+    }
+    const uint64_t packed = Pack(key);
+    const auto found = LowerBound(*table, packed);
+    return found != table->end() && found->m_packed == packed ? &*found
+                                                              : nullptr;
+  }
+
+  static void Publish(Shard &shard, std::unique_ptr<Table> table) {
+    const Table *previous = shard.m_table.exchange(table.release());
+    if (previous != nullptr) {
+      Epoch::Retire(previous);
+    }
+  }
+
+  std::array<Shard, s_shardCount> m_shards;
+  std::atomic<size_t> m_size{0};
+};
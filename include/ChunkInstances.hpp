@@ -0,0 +1,41 @@
+#pragma once
+#include "../include/Cube.hpp"
+#include "../include/CubePalette.hpp"
+
+#include <glad/glad.h>
+#include <glm/glm.hpp>
+
+#include <vector>
+
+// Przesuniecia widocznych kostek z warstwa tekstury typu, rysowane instancjami
+// wspolnej geometrii kostki jednym wywolaniem na chunk
+class ChunkInstances {
+public:
+  ChunkInstances() = default;
+  ChunkInstances(const ChunkInstances &) = delete;
+  ChunkInstances &operator=(const ChunkInstances &) = delete;
+  ChunkInstances(ChunkInstances &&) noexcept;
+  ChunkInstances &operator=(ChunkInstances &&) noexcept;
+  ~ChunkInstances();
+
+  void Clear();
+  void Add(int layer, const glm::vec3 &offset);
+
+  // Sends the offsets to the instance buffer and releases the CPU copy.
+  void Upload();
+  void Draw(const CubePalette &palette) const;
+
+  size_t InstanceCount() const { return m_count; }
+
+private:
+  struct Instance {
+    glm::vec3 m_offset;
+    GLfloat m_layer;
+  };
+
+  GLuint m_vbo{0};
+
+  std::vector<Instance> m_instances;
+  // Liczba instancji w buforze (CPU-side kopia jest zwalniana po Upload)
+  size_t m_count{0};
+};
@@ -0,0 +1,56 @@
+#pragma once
+#include "../include/Cube.hpp"
+#include "../include/CubePalette.hpp"
+
+#include <glad/glad.h>
+#include <glm/glm.hpp>
+
+#include <vector>
+
+// Geometria calego chunk'a w jednym VBO/EBO; typ kostki to warstwa tablicy
+// tekstur w wierzcholku, wiec caly chunk to jedno wywolanie rysowania
+class ChunkMesh {
+public:
+  enum class Mode {
+    Faces,  // Osobny quad dla kazdej odslonietej sciany
+    Greedy  // Sasiednie sciany tego samego typu scalone w prostokaty
+  };
+
+  struct Vertex {
+    glm::vec3 m_position;
+    glm::vec2 m_texCoord; // W kafelkach, powtarza sie na scalonych scianach
+    glm::vec2 m_tile;
+    GLfloat m_layer; // Warstwa tekstury typu (CubePalette::Layer)
+  };
+
+  ChunkMesh() = default;
+  ChunkMesh(const ChunkMesh &) = delete;
+  ChunkMesh &operator=(const ChunkMesh &) = delete;
+  ChunkMesh(ChunkMesh &&) noexcept;
+  ChunkMesh &operator=(ChunkMesh &&) noexcept;
+  ~ChunkMesh();
+
+  void Clear();
+  void Reserve(size_t faceCount);
+  // Extent is the face size in cells along x, y and z (1 along its normal).
+  void AddFace(int layer, const glm::vec3 &offset, Cube::Face face,
+               const glm::ivec3 &extent = glm::ivec3(1));
+
+  // Sends the CPU-side geometry to the GPU and releases the CPU copy.
+  void Upload();
+  void Draw(const CubePalette &palette) const;
+
+  size_t TriangleCount() const;
+
+private:
+  void AddQuad(const std::array<Vertex, 4> &quad);
+
+  GLuint m_vbo{0};
+  GLuint m_vao{0};
+  GLuint m_ebo{0};
+
+  std::vector<Vertex> m_vertices;
+  std::vector<GLuint> m_indices;
+  // Liczba indeksow w EBO (CPU-side kopia jest zwalniana po Upload)
+  size_t m_indexCount{0};
+};
@@ -0,0 +1,111 @@
+#pragma once
+#include <glm/glm.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdlib>
+#include <vector>
+
+// Okno size x size slotow wokol ruchomego punktu (toroidalnie): klucz (x, z)
+// trafia do slotu (x mod size, z mod size). Przesuniecie okna o jeden chunk
+// zwalnia tylko jeden rzad slotow, a slot jest od razu uzywany przez klucz
+// wchodzacy; sloty sa alokowane raz, w konstruktorze.
+template <typename T> class Clipmap {
+public:
+  using Key = glm::ivec2;
+
+  explicit Clipmap(int size, const Key &origin = Key(0, 0))
+      : m_size(size), m_origin(origin),
+        m_slots(static_cast<size_t>(size) * static_cast<size_t>(size)) {}
+
+  int Size() const { return m_size; }
+  // Najmniejszy klucz w oknie
+  Key Origin() const { return m_origin; }
+
+  bool Contains(const Key &key) const {
+    return key.x >= m_origin.x && key.x < m_origin.x + m_size &&
+           key.y >= m_origin.y && key.y < m_origin.y + m_size;
+  }
+
+  // Klucz musi byc w oknie (Contains)
+  T &At(const Key &key) { return m_slots[Index(key)]; }
+  const T &At(const Key &key) const { return m_slots[Index(key)]; }
+
+  // Przesuwa okno do origin. recycle(slot, from, to) jest wywolywane dla
+  // kazdego klucza from, ktory wychodzi z okna; jego slot nalezy odtad do
+  // klucza to, ktory wchodzi.
+  template <typename Recycle> void MoveTo(const Key &origin, Recycle &&recycle) {
+    const Key previous = m_origin;
+    m_origin = origin;
+    auto move = [&](const Key &from) {
+      const Key to(origin.x + Wrap(from.x - origin.x, m_size),
+                   origin.y + Wrap(from.y - origin.y, m_size));
+      recycle(m_slots[Index(from)], from, to);
+    };
+
+    const Key delta = origin - previous;
+    if (std::abs(delta.x) >= m_size || std::abs(delta.y) >= m_size) {
+      for (int y = previous.y; y < previous.y + m_size; ++y) {
+        for (int x = previous.x; x < previous.x + m_size; ++x) {
+          move(Key(x, y));
+        }
+      }
+      return;
+    }
+
+    // Kolumny x, ktore wychodza z okna (wszystkie wiersze)
+    const int keptFromX = std::max(previous.x, origin.x);
+    const int keptToX = std::min(previous.x, origin.x) + m_size;
+    for (int x = previous.x; x < previous.x + m_size; ++x) {
+      if (x >= keptFromX && x < keptToX) {
+        continue;
+      }
+      for (int y = previous.y; y < previous.y + m_size; ++y) {
+        move(Key(x, y));
+      }
+    }
+    // Wiersze y, ktore wychodza, w kolumnach, ktore zostaja
+    const int keptFromY = std::max(previous.y, origin.y);
+    const int keptToY = std::min(previous.y, origin.y) + m_size;
+    for (int y = previous.y; y < previous.y + m_size; ++y) {
+      if (y >= keptFromY && y < keptToY) {
+        continue;
+      }
+      for (int x = keptFromX; x < keptToX; ++x) {
+        move(Key(x, y));
+      }
+    }
+  }
+
+  // visit(slot, key) dla kazdego klucza okna
+  template <typename Visit> void ForEach(Visit &&visit) {
+    for (int y = m_origin.y; y < m_origin.y + m_size; ++y) {
+      for (int x = m_origin.x; x < m_origin.x + m_size; ++x) {
+        visit(At(Key(x, y)), Key(x, y));
+      }
+    }
+  }
+  template <typename Visit> void ForEach(Visit &&visit) const {
+    for (int y = m_origin.y; y < m_origin.y + m_size; ++y) {
+      for (int x = m_origin.x; x < m_origin.x + m_size; ++x) {
+        visit(At(Key(x, y)), Key(x, y));
+      }
+    }
+  }
+
+private:
+  static int Wrap(int value, int size) {
+    const int wrapped = value % size;
+    return wrapped < 0 ? wrapped + size : wrapped;
+  }
+
+  size_t Index(const Key &key) const {
+    return static_cast<size_t>(Wrap(key.y, m_size)) *
+               static_cast<size_t>(m_size) +
+           static_cast<size_t>(Wrap(key.x, m_size));
+  }
+
+  int m_size;
+  Key m_origin;
+  std::vector<T> m_slots;
+};
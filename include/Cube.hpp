@@ -1,38 +1,59 @@
 #pragma once
 #include <glad/glad.h>
+#include <glm/glm.hpp>
 
 #include <array>
+#include <cstdint>
 #include <string>
 
 class Cube {
 public:
-  enum class Type { None, Grass, Stone, Grass_debug };
-
-  Cube(const std::string &texturePath);
+  enum class Type : uint8_t { None, Grass, Stone, Grass_debug };
+  // Sciany w kolejnosci s_vertices
+  enum class Face { Front, Back, Left, Right, Bottom, Top };
+  static constexpr size_t s_faceCount = 6;
+  static constexpr uint8_t s_allFaces = 0x3F;
+
+  // Bit sciany w 6-bitowej masce odslonietych scian
+  static constexpr uint8_t FaceBit(Face face) {
+    return static_cast<uint8_t>(1u << static_cast<unsigned>(face));
+  }
+
+  // Rozmiar jednej sciany w teksturze (rozlozony szescian 4x3)
+  static constexpr float s_tileWidth = 0.25f;
+  static constexpr float s_tileHeight = 1.0f / 3.0f;
+
+  struct Corner {
+    glm::vec3 m_position; // Wzgledem srodka kostki
+    glm::vec2 m_texCoord; // W kafelkach (0 albo 1), powtarzane w shaderze
+    glm::vec2 m_tile;     // Lewy dolny rog sciany w teksturze
+  };
+
+  // Four unique corners of a face; triangles are (0, 1, 2) and (2, 3, 0).
+  static std::array<Corner, 4> FaceCorners(Face face);
+  // Offset to the neighbouring cell that the face looks at.
+  static glm::ivec3 FaceDirection(Face face);
+  // Sciany parami: Front/Back, Left/Right, Bottom/Top
+  static constexpr Face Opposite(Face face) {
+    return static_cast<Face>(static_cast<unsigned>(face) ^ 1u);
+  }
+
+  // Tekstura typu jest warstwa layer tablicy tekstur z CubePalette, a vao to
+  // wspolna geometria z CubeGeometry (kostka jej nie posiada)
+  Cube(Type type, int layer, GLuint vao);
   Cube(Type type = Type::None) : m_type(type) {}
 
   Type GetType() const { return m_type; }
+  int Layer() const { return m_layer; }
 
-  Cube() = delete;
-  Cube(const Cube &) = delete;
-  Cube &operator=(const Cube &) = delete;
-  Cube(Cube &&) noexcept;
-  Cube &operator=(Cube &&) noexcept;
-  ~Cube();
-
-  GLuint Vbo() const { return m_vbo; }
   GLuint Vao() const { return m_vao; }
+  // Expects the palette texture array to be bound.
   void Draw() const;
-  GLuint Texture() const { return m_texture; }
 
 private:
-  GLuint m_vbo{0};
   GLuint m_vao{0};
-  GLuint m_ebo{0};
-  GLuint m_texture{0};
   Type m_type;
+  int m_layer{0};
 
   static std::array<float, 6 * 6 * 5> s_vertices;
-
-  GLuint CreateTexture(const std::string &texturePath);
 };
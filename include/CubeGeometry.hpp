@@ -0,0 +1,26 @@
+#pragma once
+#include <glad/glad.h>
+
+#include <cstddef>
+
+// Indeksowana geometria kostki (24 wierzcholki, 36 indeksow) w jednym VAO,
+// wspolna dla wszystkich typow z CubePalette
+class CubeGeometry {
+public:
+  static constexpr size_t s_vertexCount = 24;
+  static constexpr size_t s_indexCount = 36;
+
+  CubeGeometry();
+  CubeGeometry(const CubeGeometry &) = delete;
+  CubeGeometry &operator=(const CubeGeometry &) = delete;
+  CubeGeometry(CubeGeometry &&) noexcept;
+  CubeGeometry &operator=(CubeGeometry &&) noexcept;
+  ~CubeGeometry();
+
+  GLuint Vao() const { return m_vao; }
+
+private:
+  GLuint m_vbo{0};
+  GLuint m_ebo{0};
+  GLuint m_vao{0};
+};
@@ -1,15 +1,36 @@
 #pragma once
 
 #include "../include/Cube.hpp"
+#include "../include/CubeGeometry.hpp"
 
+#include <glad/glad.h>
+
+#include <string>
 #include <unordered_map>
+#include <utility>
+#include <vector>
 
 class CubePalette {
 public:
   CubePalette();
+  CubePalette(const CubePalette &) = delete;
+  CubePalette &operator=(const CubePalette &) = delete;
+  ~CubePalette();
 
   const Cube &LookUp(Cube::Type type) const;
+  // Warstwa tekstury typu w tablicy tekstur
+  int Layer(Cube::Type type) const { return LookUp(type).Layer(); }
+  // Geometria kostki jest wspolna dla kazdego typu
+  GLuint Vao() const { return m_geometry.Vao(); }
+
+  // Binds the texture array with every block type on texture unit 0.
+  void Bind() const;
 
 private:
+  // Jedna warstwa GL_TEXTURE_2D_ARRAY na plik; wszystkie musza miec ten sam rozmiar
+  static GLuint CreateTexture(const std::vector<std::string> &texturePaths);
+
+  CubeGeometry m_geometry;
   std::unordered_map<Cube::Type, Cube> m_palette;
+  GLuint m_texture{0};
 };
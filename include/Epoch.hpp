@@ -0,0 +1,49 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+// Odzyskiwanie pamieci oparte na epokach: czytelnik w sekcji Guard moze
+// trzymac wskazniki do obiektow, ktore pisarz juz podmienil; Retire zwalnia
+// obiekt dopiero, gdy wszyscy czytelnicy, ktorzy mogli go widziec, wyszli.
+// Wejscie i wyjscie z sekcji to zapis do wlasnego slotu watku, bez blokad.
+class Epoch {
+public:
+  // Do tylu watkow naraz w sekcjach (sloty sa zwalniane przy konczeniu watku)
+  static constexpr size_t s_maxThreads = 256;
+
+  class Guard {
+  public:
+    Guard();
+    Guard(const Guard &) = delete;
+    Guard &operator=(const Guard &) = delete;
+    ~Guard();
+  };
+
+  // The object must already be unreachable for readers entering from now on.
+  template <typename T> static void Retire(const T *object) {
+    Retire(const_cast<T *>(object),
+           [](void *pointer) { delete static_cast<T *>(pointer); });
+  }
+  static void Retire(void *object, void (*deleter)(void *));
+  // Zwalnia, co sie da; zwraca liczbe zwolnionych obiektow
+  static size_t Reclaim();
+  static size_t Pending();
+
+private:
+  struct alignas(64) Slot {
+    // 0: watek poza sekcja, inaczej epoka z chwili wejscia
+    std::atomic<uint64_t> m_epoch{0};
+    std::atomic<bool> m_claimed{false};
+  };
+
+  struct Domain;
+
+  static Domain &GetDomain();
+  // Slot watku i glebokosc zagniezdzenia jego sekcji
+  static Slot &ThreadSlot(size_t *&depth);
+  // Najmniejsza epoka aktywnego czytelnika (UINT64_MAX, gdy nie ma zadnego)
+  static uint64_t OldestReader();
+  static size_t ReclaimLocked(Domain &domain);
+};
@@ -0,0 +1,29 @@
+#pragma once
+#include <glad/glad.h>
+
+// Bufor ramki poza ekranem: kolor RGBA8 i glebia/stencil w renderbufferach
+class Framebuffer {
+public:
+  Framebuffer(GLsizei width, GLsizei height);
+  Framebuffer(const Framebuffer &) = delete;
+  Framebuffer &operator=(const Framebuffer &) = delete;
+  Framebuffer(Framebuffer &&) noexcept;
+  Framebuffer &operator=(Framebuffer &&) noexcept;
+  ~Framebuffer();
+
+  // False, gdy sterownik odrzucil zestaw zalacznikow
+  bool Complete() const { return m_complete; }
+  // Ustawia tez viewport na caly bufor
+  void Bind() const;
+
+  GLsizei Width() const { return m_width; }
+  GLsizei Height() const { return m_height; }
+
+private:
+  GLuint m_fbo{0};
+  GLuint m_color{0};
+  GLuint m_depth{0};
+  GLsizei m_width{0};
+  GLsizei m_height{0};
+  bool m_complete{false};
+};
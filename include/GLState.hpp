@@ -0,0 +1,60 @@
+#pragma once
+#include <glad/glad.h>
+
+#include <array>
+#include <cstddef>
+
+// Cache stanu GL biezacego kontekstu: wiazania, ktore niczego nie zmieniaja, sa
+// pomijane. Wszystkie wiazania w projekcie ida przez te funkcje, a usuwanie
+// obiektow przez Delete*, zeby cache nie wskazywal na zwolnione nazwy.
+class GLState {
+public:
+  struct Counters {
+    size_t m_issued{0};
+    size_t m_skipped{0};
+  };
+
+  static void UseProgram(GLuint program);
+  static void BindVertexArray(GLuint vao);
+  // GL_ELEMENT_ARRAY_BUFFER nalezy do VAO, wiec jest przekazywany bez cache
+  static void BindBuffer(GLenum target, GLuint buffer);
+  static void ActiveTexture(GLenum unit);
+  static void BindTexture(GLenum target, GLuint texture);
+
+  static void DeleteProgram(GLuint program);
+  static void DeleteVertexArray(GLuint vao);
+  static void DeleteBuffer(GLuint buffer);
+  static void DeleteTexture(GLuint texture);
+
+  // Forgets everything, e.g. after code that changed GL state directly.
+  static void Invalidate();
+
+  // Zamyka licznik klatki; LastFrame zwraca wynik ostatniej zamknietej klatki
+  static void EndFrame();
+  static Counters LastFrame();
+
+private:
+  static constexpr GLuint s_unknown = ~GLuint(0);
+  static constexpr size_t s_textureUnits = 16;
+  // Sledzone cele tekstur: GL_TEXTURE_2D i GL_TEXTURE_2D_ARRAY
+  static constexpr size_t s_textureTargets = 2;
+
+  struct State {
+    GLuint m_program{s_unknown};
+    GLuint m_vao{s_unknown};
+    GLuint m_arrayBuffer{s_unknown};
+    GLuint m_uniformBuffer{s_unknown};
+    GLenum m_activeUnit{s_unknown};
+    std::array<std::array<GLuint, s_textureTargets>, s_textureUnits> m_textures;
+    Counters m_frame;
+    Counters m_lastFrame;
+
+    State();
+  };
+
+  static State &Current();
+  // Zwraca true, gdy wywolanie GL jest potrzebne (i zapamietuje nowa wartosc)
+  static bool Change(GLuint &cached, GLuint value);
+  static GLuint *CachedBuffer(GLenum target);
+  static GLuint *CachedTexture(GLenum target);
+};
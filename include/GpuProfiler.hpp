@@ -0,0 +1,73 @@
+#pragma once
+#include <glad/glad.h>
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+// Czas przebiegow klatki na CPU i GPU (zapytania GL_TIMESTAMP). Zapytania
+// kraza w pierscieniu s_frames klatek i sa odczytywane dopiero, gdy GPU ma
+// wynik, wiec profiler nigdy nie czeka na GPU; wyniki spozniaja sie o 1-3 klatki.
+class GpuProfiler {
+public:
+  enum class Pass { Clear, Draw, Present, Count };
+  static constexpr size_t s_passCount = static_cast<size_t>(Pass::Count);
+  static constexpr size_t s_frames = 4;
+
+  // Czasy jednej klatki w ms
+  struct Timings {
+    size_t m_frame{0};
+    std::array<double, s_passCount> m_cpu{};
+    std::array<double, s_passCount> m_gpu{};
+    bool m_valid{false};
+
+    double CpuTotal() const;
+    double GpuTotal() const;
+    // CPU time spent issuing commands; Present is left out because
+    // display() blocks on the GPU (and vsync) rather than doing CPU work.
+    double CpuSubmit() const;
+    bool GpuBound() const { return GpuTotal() > CpuSubmit(); }
+  };
+
+  GpuProfiler();
+  GpuProfiler(const GpuProfiler &) = delete;
+  GpuProfiler &operator=(const GpuProfiler &) = delete;
+  ~GpuProfiler();
+
+  void BeginFrame();
+  void Begin(Pass pass);
+  void End(Pass pass);
+  // Odczytuje gotowe klatki i dodaje najnowsza do RenderStats
+  void EndFrame();
+
+  const Timings &Latest() const { return m_latest; }
+  // Klatki, ktorych wynik nie byl gotowy przed ponownym uzyciem slotu
+  size_t Dropped() const { return m_dropped; }
+
+  static const char *Name(Pass pass);
+
+private:
+  using Clock = std::chrono::steady_clock;
+
+  // Zapytanie 2 * pass to poczatek przebiegu, 2 * pass + 1 jego koniec
+  struct Slot {
+    std::array<GLuint, 2 * s_passCount> m_queries{};
+    std::array<Clock::time_point, 2 * s_passCount> m_cpu{};
+    uint32_t m_issued{0};
+    GLuint m_lastQuery{0};
+    size_t m_frame{0};
+    bool m_pending{false};
+  };
+
+  void Mark(Pass pass, size_t end);
+  // Zwraca false, gdy GPU nie ma jeszcze wyniku
+  bool Resolve(Slot &slot);
+
+  std::array<Slot, s_frames> m_slots;
+  size_t m_frame{0};
+  // Najstarsza klatka, ktorej wynik nie zostal jeszcze odczytany
+  size_t m_oldest{0};
+  Timings m_latest;
+  size_t m_dropped{0};
+};
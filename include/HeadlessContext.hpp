@@ -0,0 +1,27 @@
+#pragma once
+
+#include <memory>
+#include <string>
+
+// Kontekst GL 3.3 core bez okna, do benchmarkow na maszynach bez ekranu.
+// Z MAJNKRAFT_EGL (linkowane z -lEGL) uzywa EGL bez powierzchni, wiec dziala
+// bez serwera X, takze na programowym Mesa llvmpipe. Bez tej flagi uzywa
+// sf::Context, ktory na Linuksie potrzebuje serwera X (np. Xvfb).
+class HeadlessContext {
+public:
+  HeadlessContext();
+  HeadlessContext(const HeadlessContext &) = delete;
+  HeadlessContext &operator=(const HeadlessContext &) = delete;
+  ~HeadlessContext();
+
+  // True, gdy kontekst jest aktywny i funkcje GL zostaly zaladowane
+  bool Valid() const { return m_valid; }
+  // GL_RENDERER, np. "llvmpipe (LLVM 15.0.7, 256 bits)"
+  std::string Renderer() const;
+
+private:
+  struct Backend;
+
+  std::unique_ptr<Backend> m_backend;
+  bool m_valid{false};
+};
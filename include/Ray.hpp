@@ -2,6 +2,8 @@
 
 #include <glm/glm.hpp>
 
+#include <cstdint>
+
 class Ray {
 public:
 	using time_t = float;
@@ -15,10 +17,17 @@ public:
 
 	glm::vec3 Origin() const { return m_origin; }
 	glm::vec3 Direction() const { return m_direction; }
+	// 1 / kierunek, dla zerowej skladowej +-inf
+	glm::vec3 InverseDirection() const { return m_inverseDirection; }
+	// Bit i ustawiony, gdy promien biegnie w strone malejacych wartosci osi i
+	uint8_t SignMask() const { return m_signMask; }
+	bool Negative(int axis) const { return (m_signMask >> axis) & 1; }
 
 	glm::vec3 At(Ray::time_t t) const;
 
 private:
 	glm::vec3 m_origin;
 	glm::vec3 m_direction;
+	glm::vec3 m_inverseDirection;
+	uint8_t m_signMask;
 };
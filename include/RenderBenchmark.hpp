@@ -0,0 +1,32 @@
+#pragma once
+
+#include <cstddef>
+#include <optional>
+#include <string>
+
+// Benchmark renderowania bez okna: app --render-bench [opcje]
+//   --out <plik>     wynik JSON (domyslnie render_bench.json)
+//   --path <plik>    sciezka kamery (CameraPath); domyslnie okrazenie swiata
+//   --size <W>x<H>   rozmiar bufora ramki (domyslnie 1280x720)
+// Rysuje do FBO w kontekscie HeadlessContext, wiec dziala bez GPU i ekranu.
+class RenderBenchmark {
+public:
+  struct Options {
+    std::string m_output{"render_bench.json"};
+    std::string m_cameraPath;
+    int m_width{1280};
+    int m_height{720};
+    // Staly krok czasu sciezki na klatke: kazdy przebieg rysuje te same klatki
+    float m_step{1.0f / 60.0f};
+    size_t m_warmupFrames{30};
+  };
+
+  // Opcje od argv[first]; nullopt przy nieznanej lub blednej opcji
+  static std::optional<Options> Parse(int argc, char *argv[], int first);
+  // Returns the process exit code.
+  static int Run(const Options &options);
+
+private:
+  // Swiat to s_gridSize x s_gridSize chunk'ow 16^3
+  static constexpr int s_gridSize = 6;
+};
@@ -0,0 +1,65 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <string>
+
+// Statystyki wysylania klatki: liczniki zbierane w trakcie klatki, a po
+// EndFrame trzymane w oknie ostatnich s_window klatek (min/avg/p99/max)
+class RenderStats {
+public:
+  enum class Counter {
+    FrameTime,      // ms
+    // Rzadkie: tylko w klatkach, w ktorych GpuProfiler odczytal nowy wynik
+    GpuTime,        // ms, z GpuProfiler (klatka sprzed kilku klatek)
+    CpuSubmitTime,  // ms, wysylanie komend w tej samej klatce co GpuTime
+    DrawCalls,
+    Triangles,
+    Instances,
+    Chunks,
+    Binds,          // Wiazania wykonane przez GLState
+    SkippedBinds,   // Wiazania pominiete przez GLState
+    UniformUploads, // glUniform*
+    BufferUploads,  // glBufferData / glBufferSubData
+    Count
+  };
+  static constexpr size_t s_counterCount = static_cast<size_t>(Counter::Count);
+  static constexpr size_t s_window = 300;
+
+  struct Summary {
+    double m_min{0.0};
+    double m_avg{0.0};
+    double m_p99{0.0};
+    double m_max{0.0};
+    double m_last{0.0};
+  };
+
+  static void Add(Counter counter, double value = 1.0);
+  // Closes the frame: stores the counters (and GLState's binds) in the window
+  // and writes the file when periodic output is due.
+  static void EndFrame(double frameMilliseconds);
+
+  // Klatki bez probki licznika rzadkiego sa pomijane
+  static Summary Summarize(Counter counter);
+  static const char *Name(Counter counter);
+  static size_t Frames();
+
+  // Dopisuje jedna linie JSON z podsumowaniem okna (JSON Lines)
+  static bool Write(const std::string &path);
+  // Write co frames klatek; 0 wylacza
+  static void WriteEvery(const std::string &path, size_t frames);
+
+private:
+  struct State {
+    std::array<double, s_counterCount> m_current{};
+    std::array<bool, s_counterCount> m_added{};
+    std::array<std::array<double, s_window>, s_counterCount> m_samples{};
+    size_t m_frames{0};
+    std::string m_path;
+    size_t m_writeEvery{0};
+  };
+
+  static State &Current();
+  // Licznik, ktory nie ma wartosci w kazdej klatce (bez Add: brak probki, NaN)
+  static bool Sparse(Counter counter);
+};
@@ -2,11 +2,38 @@
 
 #include <glad/glad.h>
 #include <glm/glm.hpp>
+#include <functional>
+#include <map>
+#include <set>
 #include <string>
+#include <string_view>
 #include <utility>
 
+// Uchwyt uniformu o znanym typie; rozwiazywany raz przez getUniform,
+// niepoprawny uchwyt (location -1) jest przy ustawianiu pomijany
+template <typename T> class Uniform {
+public:
+  Uniform() = default;
+
+  bool valid() const { return location != -1; }
+  GLint getLocation() const { return location; }
+
+private:
+  friend class ShaderProgram;
+  explicit Uniform(GLint location) : location(location) {}
+
+  GLint location{-1};
+};
+
 class ShaderProgram {
 public:
+  // Aktywny uniform znaleziony po linkowaniu
+  struct UniformInfo {
+    GLint location;
+    GLenum type;
+    GLint size;
+  };
+
   ShaderProgram();
   ShaderProgram(const ShaderProgram &) = delete;
   ShaderProgram &operator=(const ShaderProgram &) = delete;
@@ -16,6 +43,19 @@ public:
 
   void use();
 
+  // Resolves a uniform once; reports a missing name or a type mismatch here,
+  // not on every set.
+  template <typename T> Uniform<T> getUniform(std::string_view name) const;
+  void set(Uniform<int> uniform, int value);
+  void set(Uniform<glm::mat4> uniform, const glm::mat4 &value);
+  // Tabela z porownaniem przezroczystym: wyszukanie po string_view bez
+  // tworzenia std::string
+  using Uniforms = std::map<std::string, UniformInfo, std::less<>>;
+  const Uniforms &getUniforms() const { return uniforms; }
+  // Macierz "model" rozwiazana raz po linkowaniu (rysowanie kazdego chunk'a)
+  Uniform<glm::mat4> getModelUniform() const { return modelUniform; }
+
+  // Ustawianie po nazwie: wyszukanie w tabeli, bez glGetUniformLocation
   void setInt(const std::string_view name, int value);
   void setMat4(const std::string_view name, const glm::mat4 &value);
 
@@ -28,10 +68,19 @@ private:
   GLuint createShader(const GLchar *shaderSource, GLenum shaderType);
   GLuint createProgram(GLuint vertexShader, GLuint fragmentShader,
                        GLuint geometryShader = 0);
+  void reflectUniforms();
+  // Binds known uniform blocks (the camera block) to their binding points.
+  void bindUniformBlocks();
+  const UniformInfo *findUniform(std::string_view name) const;
+
   GLuint programId{};
   GLuint vertexShader;
   GLuint fragmentShader;
+  Uniforms uniforms;
+  Uniform<glm::mat4> modelUniform;
+  // Nazwy juz zgloszone jako brakujace, zeby nie pisac o nich co klatke
+  mutable std::set<std::string, std::less<>> reportedNames;
 
   static std::string s_vertexShaderSource;
   static std::string s_fragmentShaderSource;
-};
\ No newline at end of file
+};
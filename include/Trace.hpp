@@ -0,0 +1,79 @@
+#pragma once
+
+// Strefy czasowe CPU eksportowane do formatu Chrome trace_event
+// (chrome://tracing, Perfetto). Wlaczane flaga kompilacji MAJNKRAFT_TRACE;
+// bez niej makra TRACE_* znikaja, a Trace.cpp jest pusty.
+//
+//   TRACE_ZONE("Chunk::Draw");   // do konca zakresu
+//
+// Nazwa musi zyc do zapisu pliku (literal napisowy, __func__).
+
+#ifdef MAJNKRAFT_TRACE
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+class Trace {
+public:
+  // Zdarzenia jednego watku czekajace na Collect
+  static constexpr size_t s_bufferSize = 1 << 14;
+  // Ostatnie zdarzenia wszystkich watkow trzymane do zapisu
+  static constexpr size_t s_historySize = 1 << 16;
+
+  class Zone {
+  public:
+    explicit Zone(const char *name);
+    Zone(const Zone &) = delete;
+    Zone &operator=(const Zone &) = delete;
+    ~Zone();
+
+  private:
+    const char *m_name;
+    int64_t m_start;
+  };
+
+  // Moves finished events from every thread's buffer into the history.
+  // Called once per frame from the main thread.
+  static void Collect();
+  // Collect, potem caly plik JSON z historia
+  static bool Write(const std::string &path);
+
+private:
+  struct Event {
+    const char *m_name;
+    int64_t m_start;    // ns od startu programu
+    int64_t m_duration; // ns
+  };
+
+  // Kolejka jeden producent (watek wlasciciel) / jeden konsument (Collect)
+  struct Buffer {
+    Event m_events[s_bufferSize];
+    std::atomic<size_t> m_head{0};
+    std::atomic<size_t> m_tail{0};
+    std::atomic<size_t> m_dropped{0};
+    uint32_t m_thread{0};
+  };
+
+  struct Registry;
+
+  static Registry &GetRegistry();
+  static int64_t Now();
+  static void Push(const Event &event);
+  static Buffer &ThreadBuffer();
+};
+
+#define TRACE_CONCAT_INNER(a, b) a##b
+#define TRACE_CONCAT(a, b) TRACE_CONCAT_INNER(a, b)
+#define TRACE_ZONE(name) Trace::Zone TRACE_CONCAT(traceZone, __LINE__)(name)
+#define TRACE_COLLECT() Trace::Collect()
+#define TRACE_WRITE(path) Trace::Write(path)
+
+#else
+
+#define TRACE_ZONE(name)
+#define TRACE_COLLECT()
+#define TRACE_WRITE(path)
+
+#endif
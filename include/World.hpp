@@ -0,0 +1,102 @@
+#pragma once
+#include "../include/Chunk.hpp"
+#include "../include/Clipmap.hpp"
+#include "../include/CubePalette.hpp"
+#include "../include/Ray.hpp"
+#include "../include/ShaderProgram.hpp"
+
+#include <glm/glm.hpp>
+
+#include <array>
+#include <cstddef>
+#include <memory>
+
+// Chunk'i wokol kamery: ladowane (generowane) w promieniu od pozycji kamery
+// i usuwane, gdy sa za daleko albo gdy zabraknie budzetu pamieci. Trzymane
+// w oknie Clipmap o boku 2 * (radius + 1) + 1 wokol chunk'a kamery.
+// Sasiednie zaladowane chunk'i znaja swoje brzegi, wiec sciany miedzy nimi
+// nie sa rysowane.
+// Wspolrzedne blokow sa swiatowe (x, y, z); klucz chunk'a to (x, z) / rozmiar.
+class World {
+public:
+  static constexpr int s_chunkSize = 16;
+  using Chunk_t = Chunk<s_chunkSize, s_chunkSize, s_chunkSize>;
+  using Key = glm::ivec2;
+
+  struct HitRecord {
+    Key m_chunk;
+    glm::ivec3 m_block;     // Trafiona kostka
+    glm::ivec3 m_neighbour; // Komorka przed nia (do stawiania kostek)
+  };
+
+  // radius w chunk'ach; budget w bajtach (Chunk::MemoryUsage wszystkich
+  // przydzielonych chunk'ow, takze zaparkowanych do ponownego uzycia)
+  World(CubePalette &palette, int radius, size_t budget);
+
+  // Wyrzuca dalekie chunk'i i laduje do s_loadsPerUpdate brakujacych,
+  // najblizsze najpierw
+  void Update(const glm::vec3 &position);
+
+  void Draw(ShaderProgram &shader) const;
+  // Najblizsze trafienie ze wszystkich zaladowanych chunk'ow
+  Ray::HitType Hit(const Ray &ray, Ray::time_t min, Ray::time_t max,
+                   HitRecord &record) const;
+  bool RemoveBlock(const glm::ivec3 &block);
+
+  // Applies to loaded chunks and to chunks loaded later.
+  void SetMeshMode(ChunkMesh::Mode mode);
+  ChunkMesh::Mode MeshMode() const { return m_meshMode; }
+  void SetDrawPath(Chunk_t::DrawPath path);
+  Chunk_t::DrawPath GetDrawPath() const { return m_drawPath; }
+
+  static Key ChunkKey(const glm::vec3 &position);
+  static Key ChunkKey(const glm::ivec3 &block);
+  // nullptr, gdy chunk nie jest zaladowany
+  const Chunk_t *Find(const Key &key) const;
+
+  size_t ChunkCount() const { return m_resident; }
+  size_t MemoryUsage() const { return m_memory; }
+  // Zaladowane i zaparkowane
+  size_t AllocatedCount() const { return m_allocated; }
+  size_t Budget() const { return m_budget; }
+
+private:
+  // Ograniczenie pracy na klatke: generowanie chunk'a jest kosztowne
+  static constexpr size_t s_loadsPerUpdate = 4;
+  static constexpr std::array<Cube::Face, 4> s_sides = {
+      Cube::Face::Front, Cube::Face::Back, Cube::Face::Left,
+      Cube::Face::Right};
+
+  // Chunk slotu jest tworzony przy pierwszym uzyciu, potem przenoszony;
+  // po Evict zostaje zaparkowany (wciaz liczony w budzecie) do Release
+  struct Slot {
+    std::unique_ptr<Chunk_t> m_chunk;
+    bool m_resident{false};
+  };
+
+  void Load(Slot &slot, const Key &key);
+  void Evict(Slot &slot, const Key &key);
+  // Zwalnia zaparkowany chunk slotu
+  void Release(Slot &slot);
+  // Zwalnia jakis zaparkowany chunk poza slotem keep; false, gdy nie ma
+  bool ReleaseParked(const Slot &keep);
+  // Laczy brzegi chunk'a z zaladowanymi sasiadami (w obie strony)
+  void Link(Chunk_t &chunk, const Key &key);
+  // Odslania brzegi sasiadow chunk'a, ktory jest usuwany
+  void Unlink(const Key &key);
+  // Zaladowany sasiad po stronie side (Front, Back, Left, Right) albo nullptr
+  Chunk_t *Neighbour(const Key &key, Cube::Face side);
+  // Najdalszy zaladowany chunk od center
+  Key Farthest(const Key &center) const;
+  static int DistanceSquared(const Key &a, const Key &b);
+
+  CubePalette &m_palette;
+  int m_radius;
+  size_t m_budget;
+  size_t m_memory{0};
+  size_t m_resident{0};
+  size_t m_allocated{0};
+  Clipmap<Slot> m_grid;
+  ChunkMesh::Mode m_meshMode{ChunkMesh::Mode::Faces};
+  Chunk_t::DrawPath m_drawPath{Chunk_t::DrawPath::Mesh};
+};
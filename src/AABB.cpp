@@ -1,6 +1,14 @@
 #include "AABB.hpp"
 #include <iostream>
 
+#include <algorithm>
+#include <cstdint>
+
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define AABB_SLAB_SSE 1
+#endif
+
 AABB::AABB(const glm::vec3& min, const glm::vec3& max)
     : m_min(min)
     , m_max(max) {
@@ -69,4 +77,98 @@ Ray::HitType AABB::Hit(const Ray& ray, Ray::time_t minTime, Ray::time_t maxTime,
     record.m_point = coords;
     record.m_axis = static_cast<Axis>(axisIndex);
     return Ray::HitType::Hit;
-}
\ No newline at end of file
+}
+
+namespace {
+
+const float s_infinity = std::numeric_limits<float>::infinity();
+
+#ifdef AABB_SLAB_SSE
+inline __m128 Load(const glm::vec3& v) {
+    return _mm_setr_ps(v.x, v.y, v.z, 0.0f);
+}
+
+// mask ? a : b, dla kazdej skladowej
+inline __m128 Select(__m128 mask, __m128 a, __m128 b) {
+    return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b));
+}
+#endif
+
+} // namespace
+
+Ray::HitType AABB::HitSlab(const Ray& ray, Ray::time_t minTime, Ray::time_t maxTime, HitRecord& record) const {
+    // Najnizsza os wsrod rownych czasow wejscia, jak w Hit (x, potem y, potem z)
+    static const uint8_t s_firstAxis[8] = { 0, 0, 1, 0, 2, 0, 1, 0 };
+
+#ifdef AABB_SLAB_SSE
+    const __m128 origin = Load(ray.Origin());
+    const __m128 inverse = Load(ray.InverseDirection());
+    const __m128 min = Load(m_min);
+    const __m128 max = Load(m_max);
+
+    // Blizsza i dalsza plaszczyzna kazdego slabu wybrana bitem znaku kierunku
+    const int sign = ray.SignMask();
+    const __m128 negative = _mm_castsi128_ps(_mm_setr_epi32(-(sign & 1), -((sign >> 1) & 1), -((sign >> 2) & 1), 0));
+    const __m128 nearPlane = Select(negative, max, min);
+    const __m128 farPlane = Select(negative, min, max);
+
+    __m128 tNear = _mm_mul_ps(_mm_sub_ps(nearPlane, origin), inverse);
+    __m128 tFar = _mm_mul_ps(_mm_sub_ps(farPlane, origin), inverse);
+    // 0 * inf (promien rownolegly, w plaszczyznie sciany) daje NaN: ta os nie ogranicza
+    const __m128 ordered = _mm_cmpord_ps(tNear, tFar);
+    tNear = Select(ordered, tNear, _mm_set1_ps(-s_infinity));
+    tFar = Select(ordered, tFar, _mm_set1_ps(s_infinity));
+
+    // Wejscie to najpozniejsze z wejsc do slabow, wyjscie - najwczesniejsze z wyjsc
+    const __m128 entry = _mm_max_ps(tNear, _mm_max_ps(_mm_shuffle_ps(tNear, tNear, _MM_SHUFFLE(3, 0, 2, 1)),
+                                                      _mm_shuffle_ps(tNear, tNear, _MM_SHUFFLE(3, 1, 0, 2))));
+    const __m128 exit = _mm_min_ps(tFar, _mm_min_ps(_mm_shuffle_ps(tFar, tFar, _MM_SHUFFLE(3, 0, 2, 1)),
+                                                    _mm_shuffle_ps(tFar, tFar, _MM_SHUFFLE(3, 1, 0, 2))));
+    const __m128 entryAxis = _mm_cmpeq_ps(tNear, entry);
+    const uint32_t axisIndex = s_firstAxis[_mm_movemask_ps(entryAxis) & 0x7];
+
+    // Punkt na scianie wejscia: w osi wejscia dokladnie jej plaszczyzna
+    const __m128 point = Select(entryAxis, nearPlane, _mm_add_ps(origin, _mm_mul_ps(entry, Load(ray.Direction()))));
+    const bool inside = (_mm_movemask_ps(_mm_and_ps(_mm_cmpge_ps(origin, min), _mm_cmple_ps(origin, max))) & 0x7) == 0x7;
+    const float entryTime = _mm_cvtss_f32(entry);
+    const float exitTime = _mm_cvtss_f32(exit);
+
+    float coords[4];
+    _mm_storeu_ps(coords, inside ? _mm_mul_ps(_mm_add_ps(min, max), _mm_set1_ps(0.5f)) : point);
+#else
+    const glm::vec3 origin = ray.Origin();
+    const glm::vec3 inverse = ray.InverseDirection();
+
+    float entryTime = -s_infinity;
+    float exitTime = s_infinity;
+    glm::vec3 nearPlane;
+    glm::vec3 tNear;
+    bool inside = true;
+    for (int i = 0; i < 3; i++) {
+        nearPlane[i] = ray.Negative(i) ? m_max[i] : m_min[i];
+        const float farPlane = ray.Negative(i) ? m_min[i] : m_max[i];
+        tNear[i] = (nearPlane[i] - origin[i]) * inverse[i];
+        float tFar = (farPlane - origin[i]) * inverse[i];
+        if (tNear[i] != tNear[i] || tFar != tFar) {
+            tNear[i] = -s_infinity;
+            tFar = s_infinity;
+        }
+        entryTime = std::max(entryTime, tNear[i]);
+        exitTime = std::min(exitTime, tFar);
+        inside = inside && origin[i] >= m_min[i] && origin[i] <= m_max[i];
+    }
+    const uint32_t axisIndex = s_firstAxis[(tNear.x == entryTime) | (tNear.y == entryTime) << 1 | (tNear.z == entryTime) << 2];
+
+    glm::vec3 coords = inside ? (m_min + m_max) / 2.0f : ray.At(entryTime);
+    if (!inside) {
+        coords[axisIndex] = nearPlane[axisIndex];
+    }
+#endif
+
+    // Jak w Hit: start wewnatrz pudelka to trafienie w srodek z czasem -1
+    const bool hit = inside | ((entryTime <= exitTime) & (entryTime >= minTime) & (entryTime <= maxTime));
+    record.m_time = inside ? -1.0f : entryTime;
+    record.m_point = glm::vec3(coords[0], coords[1], coords[2]);
+    record.m_axis = static_cast<Axis>(inside ? static_cast<uint32_t>(Axis::x) : axisIndex);
+    return hit ? Ray::HitType::Hit : Ray::HitType::Miss;
+}
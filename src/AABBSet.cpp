@@ -0,0 +1,287 @@
+#include "AABBSet.hpp"
+
+#include <limits>
+
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define AABBSET_SSE 1
+#endif
+
+namespace {
+
+const float s_infinity = std::numeric_limits<float>::infinity();
+
+// Cztery tory naraz: SSE albo zwykla tablica, z tym samym zestawem operacji
+#ifdef AABBSET_SSE
+using Lanes = __m128;
+
+inline Lanes Load(const float* values) { return _mm_loadu_ps(values); }
+inline Lanes Broadcast(float value) { return _mm_set1_ps(value); }
+inline Lanes Sub(Lanes a, Lanes b) { return _mm_sub_ps(a, b); }
+inline Lanes Mul(Lanes a, Lanes b) { return _mm_mul_ps(a, b); }
+inline Lanes Min(Lanes a, Lanes b) { return _mm_min_ps(a, b); }
+inline Lanes Max(Lanes a, Lanes b) { return _mm_max_ps(a, b); }
+inline Lanes And(Lanes a, Lanes b) { return _mm_and_ps(a, b); }
+inline Lanes Or(Lanes a, Lanes b) { return _mm_or_ps(a, b); }
+inline Lanes Equal(Lanes a, Lanes b) { return _mm_cmpeq_ps(a, b); }
+inline Lanes LessEqual(Lanes a, Lanes b) { return _mm_cmple_ps(a, b); }
+inline Lanes Ordered(Lanes a, Lanes b) { return _mm_cmpord_ps(a, b); }
+// mask ? a : b
+inline Lanes Select(Lanes mask, Lanes a, Lanes b) { return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b)); }
+inline uint32_t Bits(Lanes mask) { return static_cast<uint32_t>(_mm_movemask_ps(mask)); }
+inline void Store(float* values, Lanes lanes) { _mm_storeu_ps(values, lanes); }
+#else
+// Maski jako 1.0f / 0.0f
+struct Lanes {
+    float m_values[4];
+};
+
+template <typename Function>
+inline Lanes Map(Lanes a, Lanes b, Function&& function) {
+    Lanes result;
+    for (int i = 0; i < 4; i++) {
+        result.m_values[i] = function(a.m_values[i], b.m_values[i]);
+    }
+    return result;
+}
+
+inline Lanes Load(const float* values) { return Lanes{ { values[0], values[1], values[2], values[3] } }; }
+inline Lanes Broadcast(float value) { return Lanes{ { value, value, value, value } }; }
+inline Lanes Sub(Lanes a, Lanes b) { return Map(a, b, [](float x, float y) { return x - y; }); }
+inline Lanes Mul(Lanes a, Lanes b) { return Map(a, b, [](float x, float y) { return x * y; }); }
+inline Lanes Min(Lanes a, Lanes b) { return Map(a, b, [](float x, float y) { return x < y ? x : y; }); }
+inline Lanes Max(Lanes a, Lanes b) { return Map(a, b, [](float x, float y) { return x > y ? x : y; }); }
+inline Lanes And(Lanes a, Lanes b) { return Map(a, b, [](float x, float y) { return x * y; }); }
+inline Lanes Or(Lanes a, Lanes b) { return Map(a, b, [](float x, float y) { return x + y > 0.0f ? 1.0f : 0.0f; }); }
+inline Lanes Equal(Lanes a, Lanes b) { return Map(a, b, [](float x, float y) { return x == y ? 1.0f : 0.0f; }); }
+inline Lanes LessEqual(Lanes a, Lanes b) { return Map(a, b, [](float x, float y) { return x <= y ? 1.0f : 0.0f; }); }
+inline Lanes Ordered(Lanes a, Lanes b) { return Map(a, b, [](float x, float y) { return x == x && y == y ? 1.0f : 0.0f; }); }
+inline Lanes Select(Lanes mask, Lanes a, Lanes b) {
+    Lanes result;
+    for (int i = 0; i < 4; i++) {
+        result.m_values[i] = mask.m_values[i] != 0.0f ? a.m_values[i] : b.m_values[i];
+    }
+    return result;
+}
+inline uint32_t Bits(Lanes mask) {
+    uint32_t bits = 0;
+    for (int i = 0; i < 4; i++) {
+        bits |= (mask.m_values[i] != 0.0f ? 1u : 0u) << i;
+    }
+    return bits;
+}
+inline void Store(float* values, Lanes lanes) {
+    for (int i = 0; i < 4; i++) {
+        values[i] = lanes.m_values[i];
+    }
+}
+#endif
+
+// Trzy osie po cztery tory
+struct Lanes3 {
+    Lanes m_axes[3];
+};
+
+// Wynik testu slabow dla czterech par promien - pudelko
+struct SlabResult {
+    uint32_t m_hit;
+    uint32_t m_inside;
+    uint32_t m_entryX; // Os wejscia x (bit toru)
+    uint32_t m_entryY;
+    float m_entry[4];
+};
+
+// Ten sam test co AABB::HitSlab, tylko tory to rozne promienie albo rozne pudelka
+inline SlabResult Slab(const Lanes3& origin, const Lanes3& inverse,
+                       const Lanes3& min, const Lanes3& max,
+                       Ray::time_t minTime, Ray::time_t maxTime) {
+    Lanes tNear[3];
+    Lanes entry = Broadcast(-s_infinity);
+    Lanes exit = Broadcast(s_infinity);
+    Lanes inside = Equal(entry, entry);
+    for (int i = 0; i < 3; i++) {
+        const Lanes t1 = Mul(Sub(min.m_axes[i], origin.m_axes[i]), inverse.m_axes[i]);
+        const Lanes t2 = Mul(Sub(max.m_axes[i], origin.m_axes[i]), inverse.m_axes[i]);
+        // 0 * inf (promien w plaszczyznie sciany) daje NaN: ta os nie ogranicza
+        const Lanes ordered = Ordered(t1, t2);
+        tNear[i] = Select(ordered, Min(t1, t2), Broadcast(-s_infinity));
+        entry = Max(entry, tNear[i]);
+        exit = Min(exit, Select(ordered, Max(t1, t2), Broadcast(s_infinity)));
+        inside = And(inside, And(LessEqual(min.m_axes[i], origin.m_axes[i]), LessEqual(origin.m_axes[i], max.m_axes[i])));
+    }
+
+    const Lanes inRange = And(LessEqual(entry, exit),
+                              And(LessEqual(Broadcast(minTime), entry), LessEqual(entry, Broadcast(maxTime))));
+
+    SlabResult result;
+    result.m_hit = Bits(Or(inside, inRange));
+    result.m_inside = Bits(inside);
+    result.m_entryX = Bits(Equal(tNear[0], entry));
+    result.m_entryY = Bits(Equal(tNear[1], entry));
+    Store(result.m_entry, entry);
+    return result;
+}
+
+// Rekord jak z AABB::Hit dla toru lane, ktory trafil
+void FillRecord(const SlabResult& result, int lane, const glm::vec3& origin, const glm::vec3& direction,
+                uint8_t signMask, const glm::vec3& min, const glm::vec3& max, AABB::HitRecord& record) {
+    if ((result.m_inside >> lane) & 1) {
+        record.m_time = -1.0f;
+        record.m_point = (min + max) / 2.0f;
+        record.m_axis = AABB::Axis::x;
+        return;
+    }
+
+    const int axis = (result.m_entryX >> lane) & 1 ? 0 : ((result.m_entryY >> lane) & 1 ? 1 : 2);
+    record.m_time = result.m_entry[lane];
+    record.m_point = origin + direction * record.m_time;
+    record.m_point[axis] = (signMask >> axis) & 1 ? max[axis] : min[axis];
+    record.m_axis = static_cast<AABB::Axis>(axis);
+}
+
+} // namespace
+
+bool RayPacket::Add(const Ray& ray) {
+    if (m_count == s_size) {
+        return false;
+    }
+    for (int i = 0; i < 3; i++) {
+        m_origin[i][m_count] = ray.Origin()[i];
+        m_direction[i][m_count] = ray.Direction()[i];
+        m_inverseDirection[i][m_count] = ray.InverseDirection()[i];
+    }
+    m_signMask[m_count] = ray.SignMask();
+    ++m_count;
+    return true;
+}
+
+size_t AABBSet::Add(const AABB& box) {
+    // Nowy blok s_batch pudelek i s_batch - 1 za nim, zeby okno HitBatch od
+    // dowolnego first sie miescilo; nieuzywane tory sa maskowane przez m_count
+    if (m_count % s_batch == 0) {
+        for (int i = 0; i < 3; i++) {
+            m_min[i].resize(m_count + 2 * s_batch - 1, 0.0f);
+            m_max[i].resize(m_count + 2 * s_batch - 1, 0.0f);
+        }
+    }
+    for (int i = 0; i < 3; i++) {
+        m_min[i][m_count] = box.Min()[i];
+        m_max[i][m_count] = box.Max()[i];
+    }
+    return m_count++;
+}
+
+void AABBSet::Clear() {
+    for (int i = 0; i < 3; i++) {
+        m_min[i].clear();
+        m_max[i].clear();
+    }
+    m_count = 0;
+}
+
+AABB AABBSet::Get(size_t index) const {
+    return AABB(glm::vec3(m_min[0][index], m_min[1][index], m_min[2][index]),
+                glm::vec3(m_max[0][index], m_max[1][index], m_max[2][index]));
+}
+
+uint32_t AABBSet::HitBatch(const Ray& ray, size_t first, Ray::time_t minTime, Ray::time_t maxTime, Records& records) const {
+    const glm::vec3 origin = ray.Origin();
+    const glm::vec3 inverse = ray.InverseDirection();
+    const Lanes3 origins = { { Broadcast(origin.x), Broadcast(origin.y), Broadcast(origin.z) } };
+    const Lanes3 inverses = { { Broadcast(inverse.x), Broadcast(inverse.y), Broadcast(inverse.z) } };
+
+    uint32_t hits = 0;
+    for (size_t block = 0; block < s_batch; block += 4) {
+        const size_t offset = first + block;
+        if (offset >= m_count) {
+            break;
+        }
+        const Lanes3 min = { { Load(&m_min[0][offset]), Load(&m_min[1][offset]), Load(&m_min[2][offset]) } };
+        const Lanes3 max = { { Load(&m_max[0][offset]), Load(&m_max[1][offset]), Load(&m_max[2][offset]) } };
+        const SlabResult result = Slab(origins, inverses, min, max, minTime, maxTime);
+
+        uint32_t lanes = result.m_hit;
+        if (m_count - offset < 4) {
+            lanes &= (1u << (m_count - offset)) - 1;
+        }
+        hits |= lanes << block;
+        for (int lane = 0; lanes != 0; ++lane, lanes >>= 1) {
+            if (lanes & 1) {
+                const AABB box = Get(offset + lane);
+                FillRecord(result, lane, origin, ray.Direction(), ray.SignMask(), box.Min(), box.Max(), records[block + lane]);
+            }
+        }
+    }
+    return hits;
+}
+
+Ray::HitType AABBSet::Hit(const Ray& ray, Ray::time_t minTime, Ray::time_t maxTime, AABB::HitRecord& record, size_t& index) const {
+    const glm::vec3 origin = ray.Origin();
+    const glm::vec3 inverse = ray.InverseDirection();
+    const Lanes3 origins = { { Broadcast(origin.x), Broadcast(origin.y), Broadcast(origin.z) } };
+    const Lanes3 inverses = { { Broadcast(inverse.x), Broadcast(inverse.y), Broadcast(inverse.z) } };
+
+    // Rekord jest wypelniany tylko dla ostatecznie najblizszego pudelka
+    bool found = false;
+    SlabResult closest{};
+    int closestLane = 0;
+    for (size_t offset = 0; offset < m_count; offset += 4) {
+        const Lanes3 min = { { Load(&m_min[0][offset]), Load(&m_min[1][offset]), Load(&m_min[2][offset]) } };
+        const Lanes3 max = { { Load(&m_max[0][offset]), Load(&m_max[1][offset]), Load(&m_max[2][offset]) } };
+        const SlabResult result = Slab(origins, inverses, min, max, minTime, maxTime);
+
+        uint32_t lanes = result.m_hit;
+        if (m_count - offset < 4) {
+            lanes &= (1u << (m_count - offset)) - 1;
+        }
+        for (int lane = 0; lanes != 0; ++lane, lanes >>= 1) {
+            if (!(lanes & 1)) {
+                continue;
+            }
+            const float time = (result.m_inside >> lane) & 1 ? -1.0f : result.m_entry[lane];
+            if (!found || time < record.m_time) {
+                found = true;
+                record.m_time = time;
+                closest = result;
+                closestLane = lane;
+                index = offset + lane;
+            }
+        }
+    }
+    if (!found) {
+        return Ray::HitType::Miss;
+    }
+
+    const AABB box = Get(index);
+    FillRecord(closest, closestLane, origin, ray.Direction(), ray.SignMask(), box.Min(), box.Max(), record);
+    return Ray::HitType::Hit;
+}
+
+uint32_t AABBSet::HitPacket(const AABB& box, const RayPacket& packet, Ray::time_t minTime, Ray::time_t maxTime, Records& records) {
+    const glm::vec3 boxMin = box.Min();
+    const glm::vec3 boxMax = box.Max();
+    const Lanes3 min = { { Broadcast(boxMin.x), Broadcast(boxMin.y), Broadcast(boxMin.z) } };
+    const Lanes3 max = { { Broadcast(boxMax.x), Broadcast(boxMax.y), Broadcast(boxMax.z) } };
+
+    uint32_t hits = 0;
+    for (size_t block = 0; block < packet.m_count; block += 4) {
+        const Lanes3 origins = { { Load(&packet.m_origin[0][block]), Load(&packet.m_origin[1][block]), Load(&packet.m_origin[2][block]) } };
+        const Lanes3 inverses = { { Load(&packet.m_inverseDirection[0][block]), Load(&packet.m_inverseDirection[1][block]), Load(&packet.m_inverseDirection[2][block]) } };
+        const SlabResult result = Slab(origins, inverses, min, max, minTime, maxTime);
+
+        uint32_t lanes = result.m_hit;
+        if (packet.m_count - block < 4) {
+            lanes &= (1u << (packet.m_count - block)) - 1;
+        }
+        hits |= lanes << block;
+        for (int lane = 0; lanes != 0; ++lane, lanes >>= 1) {
+            if (lanes & 1) {
+                const size_t ray = block + lane;
+                const glm::vec3 origin(packet.m_origin[0][ray], packet.m_origin[1][ray], packet.m_origin[2][ray]);
+                const glm::vec3 direction(packet.m_direction[0][ray], packet.m_direction[1][ray], packet.m_direction[2][ray]);
+                FillRecord(result, lane, origin, direction, packet.m_signMask[ray], boxMin, boxMax, records[ray]);
+            }
+        }
+    }
+    return hits;
+}
@@ -0,0 +1,738 @@
+#include "../include/Benchmark.hpp"
+#include "../include/AABB.hpp"
+#include "../include/AABBSet.hpp"
+#include "../include/Chunk.hpp"
+#include "../include/ChunkDirectory.hpp"
+#include "../include/ChunkMesh.hpp"
+#include "../include/Clipmap.hpp"
+#include "../include/CubePalette.hpp"
+#include "../include/Epoch.hpp"
+
+#include <SFML/Window/Context.hpp>
+#include <glad/glad.h>
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace {
+
+// Sredni czas jednego wywolania w mikrosekundach
+template <typename Function>
+double MeasureMicroseconds(size_t iterations, Function &&function) {
+  const auto start = std::chrono::steady_clock::now();
+  for (size_t i = 0; i < iterations; ++i) {
+    function(i);
+  }
+  const std::chrono::duration<double, std::micro> elapsed =
+      std::chrono::steady_clock::now() - start;
+  return elapsed.count() / static_cast<double>(iterations);
+}
+
+template <uint8_t Size> void VisibilityForSize(CubePalette &palette) {
+  using Chunk_t = Chunk<Size, Size, Size>;
+  auto chunk = std::make_unique<Chunk_t>(glm::vec2(0, 0), palette);
+  chunk->Generate();
+
+  // Ta sama sekwencja komorek dla obu wariantow
+  std::mt19937 random(42);
+  std::uniform_int_distribution<int> coordinate(0, Size - 1);
+  std::vector<glm::ivec3> cells(256);
+  for (glm::ivec3 &cell : cells) {
+    cell = glm::ivec3(coordinate(random), coordinate(random), coordinate(random));
+  }
+
+  const size_t fullIterations = Size <= 32 ? 200 : 20;
+  const double full = MeasureMicroseconds(
+      fullIterations, [&](size_t) { chunk->UpdateVisibility(); });
+
+  const size_t incrementalIterations = 100000;
+  const double incremental =
+      MeasureMicroseconds(incrementalIterations, [&](size_t i) {
+        const glm::ivec3 &cell = cells[i % cells.size()];
+        chunk->UpdateVisibility(cell.z, cell.x, cell.y);
+      });
+
+  std::cout << std::setw(3) << static_cast<int>(Size) << "^3  full "
+            << std::setw(10) << std::fixed << std::setprecision(2) << full
+            << " us  incremental " << std::setw(8) << incremental
+            << " us  speedup " << std::setprecision(0) << full / incremental
+            << "x" << std::endl;
+}
+
+template <uint8_t Size> void StorageForSize(CubePalette &palette) {
+  using Chunk_t = Chunk<Size, Size, Size>;
+  auto chunk = std::make_unique<Chunk_t>(glm::vec2(0, 0), palette);
+  const size_t empty = chunk->MemoryUsage();
+  chunk->Generate();
+  const size_t generated = chunk->MemoryUsage();
+
+  // Dawniej 8 bajtow na kostke (Cube::Type jako int + flaga widocznosci)
+  const size_t flat = size_t(Size) * Size * Size * 8;
+
+  size_t solid = 0;
+  const double read = MeasureMicroseconds(100, [&](size_t) {
+    for (size_t y = 0; y < Size; ++y) {
+      for (size_t x = 0; x < Size; ++x) {
+        for (size_t z = 0; z < Size; ++z) {
+          solid += chunk->GetType(z, x, y) != Cube::Type::None;
+        }
+      }
+    }
+  });
+
+  std::cout << std::setw(3) << static_cast<int>(Size) << "^3  empty "
+            << std::setw(8) << empty << " B  generated " << std::setw(8)
+            << generated << " B  flat array " << std::setw(8) << flat
+            << " B  read " << std::fixed << std::setprecision(2)
+            << read * 1000.0 / (size_t(Size) * Size * Size) << " ns/block"
+            << (solid == 0 ? " (empty)" : "") << std::endl;
+}
+
+template <uint8_t Size> void RaycastForSize(CubePalette &palette) {
+  using Chunk_t = Chunk<Size, Size, Size>;
+  auto solid = std::make_unique<Chunk_t>(glm::vec2(0, 0), palette);
+  solid->Generate();
+
+  // Prawie pusty chunk: zostaje tylko podloga, reszta to puste cegly
+  auto sparse = std::make_unique<Chunk_t>(glm::vec2(0, 0), palette);
+  sparse->Generate();
+  for (uint8_t y = 1; y < Size; ++y) {
+    for (uint8_t x = 0; x < Size; ++x) {
+      for (uint8_t z = 0; z < Size; ++z) {
+        sparse->RemoveBlock(x, y, z);
+      }
+    }
+  }
+
+  // Promienie z gory chunk'a w losowych kierunkach w dol
+  std::mt19937 random(7);
+  std::uniform_real_distribution<float> position(0.0f, static_cast<float>(Size));
+  std::uniform_real_distribution<float> slope(-1.0f, 1.0f);
+  std::vector<Ray> rays;
+  for (size_t i = 0; i < 1024; ++i) {
+    const glm::vec3 origin(position(random), Size + 0.5f, position(random));
+    const glm::vec3 direction(slope(random), -1.0f, slope(random));
+    rays.emplace_back(origin, glm::normalize(direction));
+  }
+
+  typename Chunk_t::HitRecord record;
+  size_t hits = 0;
+  auto measure = [&](const Chunk_t &chunk) {
+    return MeasureMicroseconds(200000, [&](size_t i) {
+      hits += chunk.Hit(rays[i % rays.size()], 0.0f, 1000.0f, record) ==
+              Ray::HitType::Hit;
+    }) * 1000.0;
+  };
+  const double sparseTime = measure(*sparse);
+  const double solidTime = measure(*solid);
+
+  std::cout << std::setw(3) << static_cast<int>(Size) << "^3  sparse "
+            << std::setw(8) << std::fixed << std::setprecision(1) << sparseTime
+            << " ns/ray  solid " << std::setw(8) << solidTime << " ns/ray"
+            << (hits == 0 ? " (no hits)" : "") << std::endl;
+}
+
+// Dane kolumny chunk'ow trzymane w oknie wokol gracza (bez generowania)
+struct WalkColumn {
+  glm::ivec2 m_key;
+  std::array<uint32_t, 32> m_data;
+
+  void Fill(const glm::ivec2 &key) {
+    m_key = key;
+    m_data.fill(static_cast<uint32_t>(key.x * 73856093 ^ key.y * 19349663));
+  }
+};
+
+struct WalkKeyHash {
+  size_t operator()(const glm::ivec2 &key) const {
+    return std::hash<uint64_t>()((uint64_t(uint32_t(key.x)) << 32) |
+                                 uint32_t(key.y));
+  }
+};
+
+// Gracz idzie po jednym chunk'u: 2/3 krokow w +x, reszta w +z
+std::vector<glm::ivec2> WalkPath(size_t steps) {
+  std::mt19937 random(17);
+  std::uniform_int_distribution<int> turn(0, 2);
+  std::vector<glm::ivec2> path(steps);
+  for (glm::ivec2 &step : path) {
+    step = turn(random) == 0 ? glm::ivec2(0, 1) : glm::ivec2(1, 0);
+  }
+  return path;
+}
+
+void WalkForRadius(int radius) {
+  const int size = 2 * radius + 1;
+  const std::vector<glm::ivec2> path = WalkPath(4096);
+  static const std::array<glm::ivec2, 4> s_neighbours = {
+      glm::ivec2(1, 0), glm::ivec2(-1, 0), glm::ivec2(0, 1), glm::ivec2(0, -1)};
+  uint64_t sink = 0;
+
+  // Mapa: przy kroku usuwany jest rzad wychodzacy i alokowany wchodzacy
+  std::unordered_map<glm::ivec2, std::unique_ptr<WalkColumn>, WalkKeyHash> map;
+  glm::ivec2 origin(0, 0);
+  for (int y = 0; y < size; ++y) {
+    for (int x = 0; x < size; ++x) {
+      auto column = std::make_unique<WalkColumn>();
+      column->Fill(glm::ivec2(x, y));
+      map.emplace(glm::ivec2(x, y), std::move(column));
+    }
+  }
+  auto mapStep = [&](size_t i) {
+    const glm::ivec2 step = path[i % path.size()];
+    // Rzad (albo kolumna) prostopadly do kroku: wychodzi z tylu, wchodzi z przodu
+    const glm::ivec2 across(step.y, step.x);
+    const glm::ivec2 back = origin;
+    const glm::ivec2 front = origin + step * size;
+    for (int j = 0; j < size; ++j) {
+      map.erase(back + across * j);
+      auto column = std::make_unique<WalkColumn>();
+      column->Fill(front + across * j);
+      map.emplace(front + across * j, std::move(column));
+    }
+    origin += step;
+  };
+  auto mapSweep = [&](size_t) {
+    for (int y = origin.y; y < origin.y + size; ++y) {
+      for (int x = origin.x; x < origin.x + size; ++x) {
+        for (const glm::ivec2 &neighbour : s_neighbours) {
+          const auto found = map.find(glm::ivec2(x, y) + neighbour);
+          sink += found != map.end() ? found->second->m_data[0] : 0;
+        }
+      }
+    }
+  };
+
+  // Clipmap: wychodzacy slot jest wypelniany od razu dla klucza wchodzacego
+  Clipmap<WalkColumn> clipmap(size);
+  clipmap.ForEach([](WalkColumn &column, const glm::ivec2 &key) { column.Fill(key); });
+  auto clipmapStep = [&](size_t i) {
+    clipmap.MoveTo(clipmap.Origin() + path[i % path.size()],
+                   [](WalkColumn &column, const glm::ivec2 &, const glm::ivec2 &to) { column.Fill(to); });
+  };
+  auto clipmapSweep = [&](size_t) {
+    const glm::ivec2 first = clipmap.Origin();
+    for (int y = first.y; y < first.y + size; ++y) {
+      for (int x = first.x; x < first.x + size; ++x) {
+        for (const glm::ivec2 &neighbour : s_neighbours) {
+          const glm::ivec2 key = glm::ivec2(x, y) + neighbour;
+          sink += clipmap.Contains(key) ? clipmap.At(key).m_data[0] : 0;
+        }
+      }
+    }
+  };
+
+  const double mapMove = MeasureMicroseconds(path.size(), mapStep);
+  const double clipmapMove = MeasureMicroseconds(path.size(), clipmapStep);
+  const size_t sweeps = 2000;
+  const double lookups = double(size) * size * s_neighbours.size();
+  const double mapLookup = MeasureMicroseconds(sweeps, mapSweep) * 1000.0 / lookups;
+  const double clipmapLookup = MeasureMicroseconds(sweeps, clipmapSweep) * 1000.0 / lookups;
+
+  std::cout << std::setw(2) << size << "x" << std::setw(2) << size << "  step: map " << std::fixed
+            << std::setprecision(2) << std::setw(7) << mapMove << " us  clipmap " << std::setw(6)
+            << clipmapMove << " us  speedup " << std::setw(5) << mapMove / clipmapMove
+            << "x  neighbour: map " << std::setw(5) << mapLookup << " ns  clipmap " << std::setw(5)
+            << clipmapLookup << " ns  speedup " << mapLookup / clipmapLookup << "x"
+            << (sink == 0 ? " " : "") << std::endl;
+}
+
+// Wartosc w katalogu: czytelnik sprawdza, czy pasuje do klucza i czy nie
+// zostala zwolniona (m_magic zerowany w destruktorze)
+struct DirectoryColumn {
+  static constexpr uint32_t s_magic = 0x6d616a6e;
+
+  explicit DirectoryColumn(const glm::ivec2 &key) { m_column.Fill(key); }
+  ~DirectoryColumn() { m_magic = 0; }
+
+  bool Valid(const glm::ivec2 &key) const {
+    return m_magic == s_magic && m_column.m_key == key &&
+           m_column.m_data[31] ==
+               static_cast<uint32_t>(key.x * 73856093 ^ key.y * 19349663);
+  }
+
+  volatile uint32_t m_magic{s_magic};
+  WalkColumn m_column;
+};
+
+// Katalog z jednym mutexem, do porownania
+class LockedDirectory {
+public:
+  std::shared_ptr<DirectoryColumn> Find(const glm::ivec2 &key) const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    const auto found = m_map.find(key);
+    return found != m_map.end() ? found->second : nullptr;
+  }
+
+  template <typename Visit> bool Read(const glm::ivec2 &key, Visit &&visit) const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    const auto found = m_map.find(key);
+    if (found == m_map.end()) {
+      return false;
+    }
+    visit(static_cast<const DirectoryColumn &>(*found->second));
+    return true;
+  }
+
+  void Insert(const glm::ivec2 &key, std::shared_ptr<DirectoryColumn> value) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_map[key] = std::move(value);
+  }
+
+  std::shared_ptr<DirectoryColumn> Erase(const glm::ivec2 &key) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    const auto found = m_map.find(key);
+    if (found == m_map.end()) {
+      return nullptr;
+    }
+    std::shared_ptr<DirectoryColumn> removed = std::move(found->second);
+    m_map.erase(found);
+    return removed;
+  }
+
+private:
+  mutable std::mutex m_mutex;
+  std::unordered_map<glm::ivec2, std::shared_ptr<DirectoryColumn>, WalkKeyHash> m_map;
+};
+
+// Pisarz chodzi po swiecie jak w WalkForRadius: usuwa rzad z tylu okna
+// i wstawia rzad z przodu, az do stop
+template <typename Directory>
+size_t DirectoryWriter(Directory &directory, int size, const std::atomic<bool> &stop) {
+  const std::vector<glm::ivec2> path = WalkPath(4096);
+  glm::ivec2 origin(0, 0);
+  size_t steps = 0;
+  while (!stop.load(std::memory_order_relaxed)) {
+    const glm::ivec2 step = path[steps++ % path.size()];
+    const glm::ivec2 across(step.y, step.x);
+    for (int j = 0; j < size; ++j) {
+      directory.Erase(origin + across * j);
+      const glm::ivec2 key = origin + step * size + across * j;
+      directory.Insert(key, std::make_shared<DirectoryColumn>(key));
+    }
+    origin += step;
+  }
+  return steps;
+}
+
+// Czytelnicy pytaja o klucze w okolicy okna pisarza (trafienia i chybienia);
+// zwraca liczbe odczytow w sekundzie, bledne wartosci dolicza do errors
+template <typename Directory>
+double DirectoryReaders(Directory &directory, size_t threads, int size, bool writer,
+                        bool copy, std::atomic<size_t> &errors) {
+  std::atomic<bool> stop{false};
+  std::atomic<size_t> reads{0};
+  std::vector<std::thread> workers;
+  for (size_t t = 0; t < threads; ++t) {
+    workers.emplace_back([&, t] {
+      std::mt19937 random(static_cast<uint32_t>(t + 1));
+      std::uniform_int_distribution<int> coordinate(-size, 4 * size);
+      size_t count = 0;
+      uint64_t sink = 0;
+      while (!stop.load(std::memory_order_relaxed)) {
+        for (int i = 0; i < 256; ++i, ++count) {
+          const glm::ivec2 key(coordinate(random), coordinate(random));
+          if (copy) {
+            const std::shared_ptr<DirectoryColumn> column = directory.Find(key);
+            if (column) {
+              sink += column->m_column.m_data[0];
+              errors += column->Valid(key) ? 0 : 1;
+            }
+          } else {
+            directory.Read(key, [&](const DirectoryColumn &column) {
+              sink += column.m_column.m_data[0];
+              errors += column.Valid(key) ? 0 : 1;
+            });
+          }
+        }
+      }
+      // Suma odczytanych danych, zeby kompilator nie pominal odczytow
+      volatile uint64_t keep = sink;
+      (void)keep;
+      reads += count;
+    });
+  }
+  std::thread writing;
+  if (writer) {
+    writing = std::thread([&] { DirectoryWriter(directory, size, stop); });
+  }
+
+  const auto start = std::chrono::steady_clock::now();
+  std::this_thread::sleep_for(std::chrono::milliseconds(300));
+  stop = true;
+  for (std::thread &worker : workers) {
+    worker.join();
+  }
+  const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+  if (writing.joinable()) {
+    writing.join();
+  }
+  return static_cast<double>(reads.load()) / elapsed.count();
+}
+
+template <typename Directory> void FillDirectory(Directory &directory, int size) {
+  for (int y = 0; y < size; ++y) {
+    for (int x = 0; x < size; ++x) {
+      directory.Insert(glm::ivec2(x, y), std::make_shared<DirectoryColumn>(glm::ivec2(x, y)));
+    }
+  }
+}
+
+// Chunk 16 x Height x 16 w srodku swiata: sasiedzi zaslaniaja boki, wiec
+// odsloniete zostaja tylko wierzch i spod
+template <uint16_t Height> void SectionsForHeight(CubePalette &palette) {
+  using Chunk_t = Chunk<16, 16, Height>;
+  auto chunk = std::make_unique<Chunk_t>(glm::vec2(0, 0), palette);
+  auto neighbour = std::make_unique<Chunk_t>(glm::vec2(16, 0), palette);
+  neighbour->Generate();
+
+  const double generate = MeasureMicroseconds(50, [&](size_t) {
+    chunk->Generate();
+    for (Cube::Face side : {Cube::Face::Front, Cube::Face::Back,
+                            Cube::Face::Left, Cube::Face::Right}) {
+      chunk->SetNeighbour(side, neighbour.get());
+    }
+  });
+  const double visibility =
+      MeasureMicroseconds(200, [&](size_t) { chunk->UpdateVisibility(); });
+
+  ChunkMesh mesh;
+  const double faces = MeasureMicroseconds(
+      200, [&](size_t) { chunk->BuildMesh(mesh, ChunkMesh::Mode::Faces); });
+  const double greedy = MeasureMicroseconds(
+      200, [&](size_t) { chunk->BuildMesh(mesh, ChunkMesh::Mode::Greedy); });
+
+  // Promienie z nieba w dol, przez wszystkie puste sekcje nad terenem
+  auto sky = std::make_unique<Chunk_t>(glm::vec2(0, 0), palette);
+  sky->Generate();
+  for (uint8_t y = 8; y < Height - 1; ++y) {
+    for (uint8_t x = 0; x < 16; ++x) {
+      for (uint8_t z = 0; z < 16; ++z) {
+        sky->RemoveBlock(x, y, z);
+      }
+    }
+  }
+  sky->RemoveBlock(0, static_cast<uint8_t>(Height - 1), 0);
+  std::mt19937 random(11);
+  std::uniform_real_distribution<float> position(0.0f, 16.0f);
+  std::uniform_real_distribution<float> slope(-0.2f, 0.2f);
+  std::vector<Ray> rays;
+  for (size_t i = 0; i < 1024; ++i) {
+    const glm::vec3 origin(position(random), Height - 1.5f, position(random));
+    rays.emplace_back(origin, glm::normalize(glm::vec3(slope(random), -1.0f, slope(random))));
+  }
+  typename Chunk_t::HitRecord record;
+  size_t hits = 0;
+  const double hit = MeasureMicroseconds(100000, [&](size_t i) {
+    hits += sky->Hit(rays[i % rays.size()], 0.0f, 1000.0f, record) == Ray::HitType::Hit;
+  }) * 1000.0;
+
+  size_t mixed = 0;
+  for (size_t section = 0; section < Chunk_t::SectionCount(); ++section) {
+    mixed += chunk->GetSectionState(section) == Chunk_t::SectionState::Mixed;
+  }
+  std::cout << "16x" << std::setw(3) << Height << "x16  mixed sections " << mixed << "/"
+            << Chunk_t::SectionCount() << "  generate " << std::fixed << std::setprecision(1)
+            << std::setw(7) << generate << " us  visibility " << std::setw(6) << visibility
+            << " us  faces " << std::setw(6) << faces << " us  greedy " << std::setw(6) << greedy
+            << " us  sky ray " << std::setw(6) << hit << " ns  memory " << chunk->MemoryUsage()
+            << " B" << (hits == 0 ? " (no hits)" : "") << std::endl;
+}
+
+} // namespace
+
+int Benchmark::Run(const std::string &name) {
+  // Chunk wymaga palety, a paleta tekstur - kontekstu GL
+  sf::Context context;
+  if (!gladLoadGLLoader((GLADloadproc)sf::Context::getFunction)) {
+    std::cerr << "Failed to initialize OpenGL context" << std::endl;
+    return -1;
+  }
+
+  const std::vector<std::pair<std::string, std::function<void()>>> benchmarks = {
+      {"visibility", &Benchmark::Visibility},
+      {"storage", &Benchmark::Storage},
+      {"raycast", &Benchmark::Raycast},
+      {"slab", &Benchmark::Slab},
+      {"batch", &Benchmark::Batch},
+      {"walk", &Benchmark::Walk},
+      {"directory", &Benchmark::Directory},
+      {"sections", &Benchmark::Sections},
+  };
+
+  bool found = false;
+  for (const auto &benchmark : benchmarks) {
+    if (name == "all" || name == benchmark.first) {
+      std::cout << "== " << benchmark.first << " ==" << std::endl;
+      benchmark.second();
+      found = true;
+    }
+  }
+
+  if (!found) {
+    std::cerr << "Unknown benchmark '" << name << "', available:";
+    for (const auto &benchmark : benchmarks) {
+      std::cerr << " " << benchmark.first;
+    }
+    std::cerr << " all" << std::endl;
+    return -1;
+  }
+  return 0;
+}
+
+// Pelne przeliczenie widocznosci kontra aktualizacja jednej edycji
+void Benchmark::Visibility() {
+  CubePalette palette;
+  VisibilityForSize<16>(palette);
+  VisibilityForSize<32>(palette);
+  VisibilityForSize<64>(palette);
+}
+
+// Pamiec chunk'a z paleta i upakowanymi indeksami
+void Benchmark::Storage() {
+  CubePalette palette;
+  StorageForSize<16>(palette);
+  StorageForSize<32>(palette);
+  StorageForSize<64>(palette);
+}
+
+// Chunk::Hit na prawie pustym i pelnym chunk'u
+void Benchmark::Raycast() {
+  CubePalette palette;
+  RaycastForSize<16>(palette);
+  RaycastForSize<32>(palette);
+  RaycastForSize<64>(palette);
+}
+
+// AABB::Hit kontra AABB::HitSlab na tych samych parach promien - pudelko
+void Benchmark::Slab() {
+  std::mt19937 random(11);
+  std::uniform_real_distribution<float> position(-8.0f, 8.0f);
+  std::uniform_real_distribution<float> extent(0.5f, 4.0f);
+  std::uniform_real_distribution<float> jitter(-1.0f, 1.0f);
+
+  const size_t count = 4096;
+  std::vector<AABB> boxes;
+  std::vector<Ray> rays;
+  for (size_t i = 0; i < count; ++i) {
+    const glm::vec3 min(position(random), position(random), position(random));
+    boxes.emplace_back(min, min + glm::vec3(extent(random), extent(random), extent(random)));
+    // Promien celuje w okolice pudelka; co osmy rownolegly do jednej z osi
+    const glm::vec3 origin(position(random), position(random), position(random));
+    glm::vec3 dir = min + glm::vec3(2.0f) - origin +
+                    glm::vec3(jitter(random), jitter(random), jitter(random)) * 2.0f;
+    if (i % 8 == 0) {
+      dir[i / 8 % 3] = 0.0f;
+    }
+    rays.emplace_back(origin, glm::normalize(dir));
+  }
+
+  size_t mismatches = 0;
+  size_t hits = 0;
+  for (size_t i = 0; i < count; ++i) {
+    AABB::HitRecord a;
+    AABB::HitRecord b;
+    const Ray::HitType ha = boxes[i].Hit(rays[i], 0.0f, 100.0f, a);
+    const Ray::HitType hb = boxes[i].HitSlab(rays[i], 0.0f, 100.0f, b);
+    hits += ha == Ray::HitType::Hit;
+    if (ha != hb || (ha == Ray::HitType::Hit &&
+                     (a.m_axis != b.m_axis || std::abs(a.m_time - b.m_time) > 1e-4f ||
+                      glm::length(a.m_point - b.m_point) > 1e-4f))) {
+      ++mismatches;
+    }
+  }
+
+  const size_t iterations = 10000000;
+  AABB::HitRecord record;
+  size_t sink = 0;
+  const double branchy = MeasureMicroseconds(iterations, [&](size_t i) {
+    sink += boxes[i % count].Hit(rays[(i * 7) % count], 0.0f, 100.0f, record) == Ray::HitType::Hit;
+  }) * 1000.0;
+  const double slab = MeasureMicroseconds(iterations, [&](size_t i) {
+    sink += boxes[i % count].HitSlab(rays[(i * 7) % count], 0.0f, 100.0f, record) == Ray::HitType::Hit;
+  }) * 1000.0;
+
+  std::cout << std::fixed << std::setprecision(2) << "Hit " << branchy
+            << " ns/test  HitSlab " << slab << " ns/test  speedup "
+            << branchy / slab << "x  (" << hits << " hits, " << mismatches
+            << " mismatches of " << count << ")" << (sink == 0 ? " " : "")
+            << std::endl;
+}
+
+// Zapytania wsadowe: promien kontra zbior pudelek i pakiet promieni kontra pudelko
+void Benchmark::Batch() {
+  std::mt19937 random(13);
+  std::uniform_real_distribution<float> position(-16.0f, 16.0f);
+  std::uniform_real_distribution<float> extent(0.5f, 2.0f);
+  std::uniform_real_distribution<float> jitter(-1.0f, 1.0f);
+
+  const size_t boxCount = 64;
+  std::vector<AABB> boxes;
+  AABBSet set;
+  for (size_t i = 0; i < boxCount; ++i) {
+    const glm::vec3 min(position(random), position(random), position(random));
+    boxes.emplace_back(min, min + glm::vec3(extent(random), extent(random), extent(random)));
+    set.Add(boxes.back());
+  }
+
+  // Promienie z zewnatrz w strone srodka sceny
+  const size_t rayCount = 1024;
+  std::vector<Ray> rays;
+  for (size_t i = 0; i < rayCount; ++i) {
+    const glm::vec3 origin = glm::normalize(glm::vec3(jitter(random), jitter(random), jitter(random))) * 40.0f;
+    rays.emplace_back(origin, glm::normalize(glm::vec3(position(random), position(random), position(random)) - origin));
+  }
+
+  auto closestScalar = [&](const Ray &ray, AABB::HitRecord &record, size_t &index) {
+    bool found = false;
+    for (size_t i = 0; i < boxCount; ++i) {
+      AABB::HitRecord current;
+      if (boxes[i].Hit(ray, 0.0f, 100.0f, current) == Ray::HitType::Hit &&
+          (!found || current.m_time < record.m_time)) {
+        record = current;
+        index = i;
+        found = true;
+      }
+    }
+    return found ? Ray::HitType::Hit : Ray::HitType::Miss;
+  };
+
+  size_t mismatches = 0;
+  size_t hits = 0;
+  for (const Ray &ray : rays) {
+    AABB::HitRecord a;
+    AABB::HitRecord b;
+    size_t indexA = 0;
+    size_t indexB = 0;
+    const Ray::HitType ha = closestScalar(ray, a, indexA);
+    const Ray::HitType hb = set.Hit(ray, 0.0f, 100.0f, b, indexB);
+    hits += ha == Ray::HitType::Hit;
+    if (ha != hb || (ha == Ray::HitType::Hit &&
+                     (indexA != indexB || a.m_axis != b.m_axis || std::abs(a.m_time - b.m_time) > 1e-4f))) {
+      ++mismatches;
+    }
+  }
+
+  size_t sink = 0;
+  const size_t iterations = 200000;
+  const double scalar = MeasureMicroseconds(iterations, [&](size_t i) {
+    AABB::HitRecord record;
+    size_t index = 0;
+    sink += closestScalar(rays[i % rayCount], record, index) == Ray::HitType::Hit;
+  });
+  const double batched = MeasureMicroseconds(iterations, [&](size_t i) {
+    AABB::HitRecord record;
+    size_t index = 0;
+    sink += set.Hit(rays[i % rayCount], 0.0f, 100.0f, record, index) == Ray::HitType::Hit;
+  });
+
+  std::cout << std::fixed << std::setprecision(2) << "1 ray vs " << boxCount
+            << " boxes: AABB::Hit " << 1.0 / scalar << " Mrays/s  AABBSet::Hit "
+            << 1.0 / batched << " Mrays/s  speedup " << scalar / batched << "x  ("
+            << hits << " hits, " << mismatches << " mismatches of " << rayCount
+            << ")" << std::endl;
+
+  // Pakiety po RayPacket::s_size promieni kontra jedno pudelko
+  std::vector<RayPacket> packets(rayCount / RayPacket::s_size);
+  for (size_t i = 0; i < rayCount; ++i) {
+    packets[i / RayPacket::s_size].Add(rays[i]);
+  }
+
+  mismatches = 0;
+  for (size_t i = 0; i < packets.size(); ++i) {
+    const AABB &box = boxes[i % boxCount];
+    AABBSet::Records records;
+    const uint32_t mask = AABBSet::HitPacket(box, packets[i], 0.0f, 100.0f, records);
+    for (size_t lane = 0; lane < RayPacket::s_size; ++lane) {
+      AABB::HitRecord record;
+      const bool hit = box.Hit(rays[i * RayPacket::s_size + lane], 0.0f, 100.0f, record) == Ray::HitType::Hit;
+      if (hit != ((mask >> lane) & 1) ||
+          (hit && (record.m_axis != records[lane].m_axis || std::abs(record.m_time - records[lane].m_time) > 1e-4f))) {
+        ++mismatches;
+      }
+    }
+  }
+
+  const double packetScalar = MeasureMicroseconds(iterations, [&](size_t i) {
+    const AABB &box = boxes[i % boxCount];
+    const size_t first = (i % packets.size()) * RayPacket::s_size;
+    AABB::HitRecord record;
+    for (size_t lane = 0; lane < RayPacket::s_size; ++lane) {
+      sink += box.Hit(rays[first + lane], 0.0f, 100.0f, record) == Ray::HitType::Hit;
+    }
+  });
+  const double packetBatched = MeasureMicroseconds(iterations, [&](size_t i) {
+    AABBSet::Records records;
+    sink += AABBSet::HitPacket(boxes[i % boxCount], packets[i % packets.size()], 0.0f, 100.0f, records);
+  });
+
+  const double raysPerPacket = static_cast<double>(RayPacket::s_size);
+  std::cout << RayPacket::s_size << " rays vs 1 box: AABB::Hit "
+            << raysPerPacket / packetScalar << " Mrays/s  AABBSet::HitPacket "
+            << raysPerPacket / packetBatched << " Mrays/s  speedup "
+            << packetScalar / packetBatched << "x  (" << mismatches
+            << " mismatches)" << (sink == 0 ? " " : "") << std::endl;
+}
+
+// Okno chunk'ow wokol idacego gracza: mapa wskaznikow kontra Clipmap
+void Benchmark::Walk() {
+  WalkForRadius(4);
+  WalkForRadius(8);
+  WalkForRadius(16);
+}
+
+void Benchmark::Directory() {
+  const int size = 17;
+  const unsigned cores = std::max(1u, std::thread::hardware_concurrency());
+
+  // Test obciazeniowy: czytelnicy kopiuja i czytaja wartosci, ktore pisarz
+  // w tym czasie usuwa; zwolniona albo cudza wartosc to blad
+  {
+    ChunkDirectory<DirectoryColumn> directory;
+    FillDirectory(directory, size);
+    std::atomic<size_t> errors{0};
+    DirectoryReaders(directory, 4, size, true, true, errors);
+    DirectoryReaders(directory, 4, size, true, false, errors);
+    std::cout << "stress: " << directory.Size() << " chunks, " << Epoch::Pending()
+              << " retired pending, errors " << errors.load() << std::endl;
+  }
+
+  for (bool writer : {false, true}) {
+    for (size_t threads : {1, 2, 4, 8}) {
+      ChunkDirectory<DirectoryColumn> directory;
+      LockedDirectory locked;
+      FillDirectory(directory, size);
+      FillDirectory(locked, size);
+      std::atomic<size_t> errors{0};
+      const double lockedReads = DirectoryReaders(locked, threads, size, writer, false, errors);
+      const double sharedReads = DirectoryReaders(directory, threads, size, writer, true, errors);
+      const double epochReads = DirectoryReaders(directory, threads, size, writer, false, errors);
+      std::cout << (writer ? "with writer " : "read only   ") << threads << " thread(s)"
+                << (threads > cores ? "*" : " ") << "  mutex " << std::fixed
+                << std::setprecision(1) << std::setw(6) << lockedReads / 1e6
+                << " M/s  Find " << std::setw(6) << sharedReads / 1e6 << " M/s  Read "
+                << std::setw(6) << epochReads / 1e6 << " M/s  speedup " << std::setprecision(2)
+                << epochReads / lockedReads << "x" << (errors == 0 ? "" : "  ERRORS")
+                << std::endl;
+    }
+  }
+  std::cout << "(* more threads than " << cores << " hardware threads)" << std::endl;
+}
+
+// Koszt chunk'a 16 i 256 kostek wysokosci: jednolite sekcje sa pomijane
+void Benchmark::Sections() {
+  CubePalette palette;
+  SectionsForHeight<16>(palette);
+  SectionsForHeight<256>(palette);
+}
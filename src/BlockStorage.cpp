@@ -0,0 +1,140 @@
+#include "../include/BlockStorage.hpp"
+
+#include <algorithm>
+#include <utility>
+
+BlockStorage::BlockStorage(size_t size, Cube::Type fill) : m_size(size) {
+  Fill(fill);
+}
+
+Cube::Type BlockStorage::Get(size_t index) const {
+  return m_palette[Index(index)];
+}
+
+void BlockStorage::Set(size_t index, Cube::Type type) {
+  const uint32_t previous = Index(index);
+  if (m_palette[previous] == type) {
+    return;
+  }
+
+  // Ostatnia kostka innego typu znika: wracamy do jednego typu bez indeksow
+  if (m_counts[previous] == 1 && PaletteSize() == 2) {
+    for (size_t entry = 0; entry < m_palette.size(); ++entry) {
+      if (m_counts[entry] != 0 && m_palette[entry] == type) {
+        Fill(type);
+        return;
+      }
+    }
+  }
+
+  const uint32_t next = FindOrAdd(type);
+  --m_counts[previous];
+  ++m_counts[next];
+  SetIndex(index, next);
+}
+
+void BlockStorage::Fill(Cube::Type type) {
+  m_bits = 0;
+  m_words.clear();
+  m_words.shrink_to_fit();
+  m_palette.assign(1, type);
+  m_counts.assign(1, static_cast<uint32_t>(m_size));
+}
+
+void BlockStorage::Compact() {
+  std::vector<uint32_t> remap(m_palette.size(), 0);
+  std::vector<Cube::Type> palette;
+  std::vector<uint32_t> counts;
+  for (size_t entry = 0; entry < m_palette.size(); ++entry) {
+    if (m_counts[entry] != 0) {
+      remap[entry] = static_cast<uint32_t>(palette.size());
+      palette.push_back(m_palette[entry]);
+      counts.push_back(m_counts[entry]);
+    }
+  }
+
+  if (palette.size() <= 1) {
+    Fill(palette.empty() ? m_palette.front() : palette.front());
+    return;
+  }
+
+  unsigned bits = 1;
+  while ((size_t(1) << bits) < palette.size()) {
+    bits *= 2;
+  }
+
+  std::vector<uint64_t> words((m_size * bits + 63) / 64, 0);
+  for (size_t index = 0; index < m_size; ++index) {
+    const size_t bit = index * bits;
+    words[bit / 64] |= static_cast<uint64_t>(remap[Index(index)]) << (bit % 64);
+  }
+  m_bits = bits;
+  m_words = std::move(words);
+  m_palette = std::move(palette);
+  m_counts = std::move(counts);
+}
+
+size_t BlockStorage::PaletteSize() const {
+  size_t used = 0;
+  for (uint32_t count : m_counts) {
+    used += count != 0;
+  }
+  return used;
+}
+
+size_t BlockStorage::MemoryUsage() const {
+  return m_words.capacity() * sizeof(uint64_t) +
+         m_palette.capacity() * sizeof(Cube::Type) +
+         m_counts.capacity() * sizeof(uint32_t);
+}
+
+uint32_t BlockStorage::Index(size_t index) const {
+  if (m_bits == 0) {
+    return 0;
+  }
+  // Szerokosc jest potega dwojki, wiec indeks nigdy nie przechodzi przez granice slowa
+  const size_t bit = index * m_bits;
+  const uint64_t mask = (uint64_t(1) << m_bits) - 1;
+  return static_cast<uint32_t>((m_words[bit / 64] >> (bit % 64)) & mask);
+}
+
+void BlockStorage::SetIndex(size_t index, uint32_t paletteIndex) {
+  const size_t bit = index * m_bits;
+  const uint64_t mask = ((uint64_t(1) << m_bits) - 1) << (bit % 64);
+  uint64_t &word = m_words[bit / 64];
+  word = (word & ~mask) | (static_cast<uint64_t>(paletteIndex) << (bit % 64));
+}
+
+uint32_t BlockStorage::FindOrAdd(Cube::Type type) {
+  uint32_t freeEntry = static_cast<uint32_t>(m_palette.size());
+  for (uint32_t entry = 0; entry < m_palette.size(); ++entry) {
+    if (m_counts[entry] == 0) {
+      freeEntry = std::min(freeEntry, entry);
+    } else if (m_palette[entry] == type) {
+      return entry;
+    }
+  }
+
+  if (freeEntry < m_palette.size()) {
+    m_palette[freeEntry] = type;
+    return freeEntry;
+  }
+
+  // Paleta sie nie miesci: podwajamy szerokosc indeksu (1, 2, 4, 8, 16 bitow)
+  if (m_palette.size() >= (size_t(1) << m_bits)) {
+    Repack(m_bits == 0 ? 1 : m_bits * 2);
+  }
+  m_palette.push_back(type);
+  m_counts.push_back(0);
+  return freeEntry;
+}
+
+void BlockStorage::Repack(unsigned bits) {
+  std::vector<uint64_t> words((m_size * bits + 63) / 64, 0);
+  for (size_t index = 0; index < m_size; ++index) {
+    const size_t bit = index * bits;
+    words[bit / 64] |= static_cast<uint64_t>(Index(index)) << (bit % 64);
+  }
+  m_bits = bits;
+  m_words = std::move(words);
+}
@@ -59,3 +59,15 @@ void Camera::Rotate(const sf::Vector2i &mouseDelta) {
   m_pitch = std::min(std::max(m_pitch, -89.0f), 89.0f);
   RecreateLookAt();
 }
+
+void Camera::SetPose(const glm::vec3 &position, float yaw, float pitch) {
+  m_position = position;
+  m_yaw = yaw;
+  m_pitch = std::min(std::max(pitch, -89.0f), 89.0f);
+  RecreateLookAt();
+}
+
+void Camera::SetAspectRatio(float aspectRatio) {
+  m_projection =
+      glm::perspective(glm::radians(45.0f), aspectRatio, 0.1f, 100.0f);
+}
@@ -0,0 +1,54 @@
+#include "../include/CameraBuffer.hpp"
+#include "../include/RenderStats.hpp"
+#include "../include/GLState.hpp"
+
+#include <cstddef>
+#include <utility>
+
+static_assert(sizeof(CameraBuffer::Data) == 3 * 64 + 16,
+              "CameraBuffer::Data must match the std140 Camera block");
+static_assert(offsetof(CameraBuffer::Data, m_position) == 3 * 64,
+              "CameraBuffer::Data must match the std140 Camera block");
+
+CameraBuffer::CameraBuffer() {
+  glGenBuffers(1, &m_ubo);
+  GLState::BindBuffer(GL_UNIFORM_BUFFER, m_ubo);
+  glBufferData(GL_UNIFORM_BUFFER, sizeof(Data), nullptr, GL_STREAM_DRAW);
+
+  // Punkt wiazania jest staly, programy podpinaja do niego swoj blok
+  glBindBufferBase(GL_UNIFORM_BUFFER, s_bindingPoint, m_ubo);
+}
+
+CameraBuffer::CameraBuffer(CameraBuffer &&rhs) noexcept
+    : m_ubo(std::exchange(rhs.m_ubo, 0)) {}
+
+CameraBuffer &CameraBuffer::operator=(CameraBuffer &&rhs) noexcept {
+  if (&rhs == this) {
+    return *this;
+  }
+
+  m_ubo = std::exchange(rhs.m_ubo, 0);
+
+  return *this;
+}
+
+CameraBuffer::~CameraBuffer() {
+  if (m_ubo == 0) {
+    return;
+  }
+  GLState::DeleteBuffer(m_ubo);
+}
+
+void CameraBuffer::Update(const Camera &camera) {
+  Data data;
+  data.m_view = camera.View();
+  data.m_projection = camera.Projection();
+  data.m_viewProjection = data.m_projection * data.m_view;
+  data.m_position = glm::vec4(camera.Position(), 1.0f);
+
+  GLState::BindBuffer(GL_UNIFORM_BUFFER, m_ubo);
+  // Orphaning: nowy magazyn zamiast czekania na GPU, ktore czyta poprzedni
+  glBufferData(GL_UNIFORM_BUFFER, sizeof(Data), nullptr, GL_STREAM_DRAW);
+  glBufferSubData(GL_UNIFORM_BUFFER, 0, sizeof(Data), &data);
+  RenderStats::Add(RenderStats::Counter::BufferUploads);
+}
@@ -0,0 +1,118 @@
+#include "../include/CameraPath.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+
+CameraPath CameraPath::Orbit(const glm::vec3 &center, float radius,
+                             float height, float duration) {
+  // Jedna klatka na 10 stopni wystarcza przy interpolacji liniowej
+  const int steps = 36;
+  const float pitch = glm::degrees(std::atan2(-height, radius));
+
+  CameraPath path;
+  for (int i = 0; i <= steps; ++i) {
+    const float angle = glm::two_pi<float>() * static_cast<float>(i) / steps;
+    const glm::vec3 position =
+        center + glm::vec3(std::cos(angle) * radius, height,
+                           std::sin(angle) * radius);
+    // Yaw kamery liczony jak w Camera::RecreateLookAt: 0 stopni to +x
+    const float yaw = glm::degrees(angle) + 180.0f;
+    path.m_keys.push_back(
+        {duration * static_cast<float>(i) / steps, position, yaw, pitch});
+  }
+  return path;
+}
+
+std::optional<CameraPath> CameraPath::Load(const std::string &path) {
+  std::ifstream file(path);
+  if (!file) {
+    std::cerr << "Failed to open camera path: " << path << std::endl;
+    return std::nullopt;
+  }
+
+  CameraPath cameraPath;
+  std::string line;
+  size_t number = 0;
+  while (std::getline(file, line)) {
+    ++number;
+    if (line.empty() || line[0] == '#') {
+      continue;
+    }
+    std::istringstream stream(line);
+    Key key;
+    if (!(stream >> key.m_time >> key.m_position.x >> key.m_position.y >>
+          key.m_position.z >> key.m_yaw >> key.m_pitch)) {
+      std::cerr << "Invalid camera key at " << path << ":" << number
+                << std::endl;
+      return std::nullopt;
+    }
+    if (!cameraPath.m_keys.empty() &&
+        key.m_time < cameraPath.m_keys.back().m_time) {
+      std::cerr << "Camera keys out of order at " << path << ":" << number
+                << std::endl;
+      return std::nullopt;
+    }
+    cameraPath.m_keys.push_back(key);
+  }
+
+  if (cameraPath.Empty()) {
+    std::cerr << "Camera path is empty: " << path << std::endl;
+    return std::nullopt;
+  }
+  return cameraPath;
+}
+
+bool CameraPath::Save(const std::string &path) const {
+  std::ofstream file(path);
+  if (!file) {
+    std::cerr << "Failed to write camera path: " << path << std::endl;
+    return false;
+  }
+  file << "# t x y z yaw pitch\n";
+  for (const Key &key : m_keys) {
+    file << key.m_time << " " << key.m_position.x << " " << key.m_position.y
+         << " " << key.m_position.z << " " << key.m_yaw << " " << key.m_pitch
+         << "\n";
+  }
+  return static_cast<bool>(file);
+}
+
+void CameraPath::Add(float time, const Camera &camera) {
+  m_keys.push_back({time, camera.Position(), camera.Yaw(), camera.Pitch()});
+}
+
+void CameraPath::Apply(float time, Camera &camera) const {
+  if (m_keys.empty()) {
+    return;
+  }
+
+  // Pierwsza klatka pozniejsza niz time; poprzednia jest poczatkiem odcinka
+  const auto next = std::upper_bound(
+      m_keys.begin(), m_keys.end(), time,
+      [](float value, const Key &key) { return value < key.m_time; });
+  if (next == m_keys.begin()) {
+    const Key &first = m_keys.front();
+    camera.SetPose(first.m_position, first.m_yaw, first.m_pitch);
+    return;
+  }
+  if (next == m_keys.end()) {
+    const Key &last = m_keys.back();
+    camera.SetPose(last.m_position, last.m_yaw, last.m_pitch);
+    return;
+  }
+
+  const Key &from = *(next - 1);
+  const Key &to = *next;
+  const float span = to.m_time - from.m_time;
+  const float t = span > 0.0f ? (time - from.m_time) / span : 1.0f;
+  camera.SetPose(glm::mix(from.m_position, to.m_position, t),
+                 glm::mix(from.m_yaw, to.m_yaw, t),
+                 glm::mix(from.m_pitch, to.m_pitch, t));
+}
+
+float CameraPath::Duration() const {
+  return m_keys.empty() ? 0.0f : m_keys.back().m_time;
+}
@@ -1,154 +1,821 @@
 #include "../include/Chunk.hpp"
+#include "../include/RenderStats.hpp"
+#include "../include/Trace.hpp"
+#include <algorithm>
+#include <cmath>
 #include <iostream>
+#include <limits>
+#include <utility>
+#include <vector>
+
+namespace {
+
+// Numer najmlodszego ustawionego bitu (bits != 0)
+int LowestBit(uint64_t bits) { return __builtin_ctzll(bits); }
+int BitCount(uint64_t bits) { return __builtin_popcountll(bits); }
+
+} // namespace
 
 // Konstruktor
-template <uint8_t Depth, uint8_t Width, uint8_t Height>
+template <uint8_t Depth, uint8_t Width, uint16_t Height>
 Chunk<Depth, Width, Height>::Chunk(const glm::vec2 &origin, CubePalette &palette)
     : m_origin(origin), m_palette(palette), m_aabb(
         glm::vec3(origin.x, 0, origin.y),
         glm::vec3(origin.x + Width, Height, origin.y + Depth)) {}
 
 // Generowanie chunk'a
-template <uint8_t Depth, uint8_t Width, uint8_t Height>
+template <uint8_t Depth, uint8_t Width, uint16_t Height>
 void Chunk<Depth, Width, Height>::Generate() {
-  for (size_t z = 0; z < Depth; ++z) {
-    for (size_t x = 0; x < Width; ++x) {
-      for (size_t y = 0; y < Height; ++y) {
-        size_t index = CoordsToIndex(z, x, y);
+  TRACE_ZONE("Chunk::Generate");
+  // Teren jest warstwowy: typ zalezy tylko od wysokosci
+  const auto layerType = [](size_t y) {
+    return y == Height - 1 ? Cube::Type::Grass  // Górna warstwa
+                           : Cube::Type::Stone; // Wnętrze
+  };
+
+  for (size_t section = 0; section < s_sectionCount; ++section) {
+    const size_t y0 = section * s_sectionHeight;
+    const Cube::Type type = layerType(y0);
+    bool uniform = true;
+    for (size_t y = y0 + 1; y < y0 + s_sectionHeight; ++y) {
+      uniform &= layerType(y) == type;
+    }
 
-        if (y == Height - 1) {
-          m_data[index].m_type = Cube::Type::Grass; // Górna warstwa
-        } else {
-          m_data[index].m_type = Cube::Type::Stone; // Wnętrze
+    // Sekcja jednego typu: bez zapisu kazdej kostki
+    if (uniform) {
+      m_sections[section].m_blocks.Fill(type);
+      const Row_t row = type == Cube::Type::None ? Row_t(0) : s_fullRow;
+      std::fill(m_occupancy.begin() + RowIndex(0, y0),
+                m_occupancy.begin() + RowIndex(0, y0 + s_sectionHeight), row);
+      continue;
+    }
+    for (size_t z = 0; z < Depth; ++z) {
+      for (size_t x = 0; x < Width; ++x) {
+        for (size_t y = y0; y < y0 + s_sectionHeight; ++y) {
+          SetBlock(z, x, y, layerType(y));
         }
       }
     }
+    m_sections[section].m_blocks.Compact();
   }
   UpdateVisibility();
+  UpdatePyramid();
+}
+
+// Metoda MoveTo
+template <uint8_t Depth, uint8_t Width, uint16_t Height>
+void Chunk<Depth, Width, Height>::MoveTo(const glm::vec2 &origin) {
+  m_origin = origin;
+  m_aabb = AABB(glm::vec3(origin.x, 0, origin.y),
+                glm::vec3(origin.x + Width, Height, origin.y + Depth));
+  // Sasiedzi w nowym miejscu sa inni
+  m_borders = {};
+  m_meshDirty = true;
+  m_instancesDirty = true;
 }
 
 // Rysowanie chunk'a
-template <uint8_t Depth, uint8_t Width, uint8_t Height>
+template <uint8_t Depth, uint8_t Width, uint16_t Height>
 void Chunk<Depth, Width, Height>::Draw(ShaderProgram &shader) const {
+  TRACE_ZONE("Chunk::Draw");
+  RenderStats::Add(RenderStats::Counter::Chunks);
   shader.use();
+  glm::mat4 model =
+      glm::translate(glm::mat4(1.0f), glm::vec3(m_origin.x, 0, m_origin.y));
+  shader.set(shader.getModelUniform(), model);
+
+  if (m_drawPath == DrawPath::Instanced) {
+    if (m_instancesDirty) {
+      BuildInstances(m_instances);
+      m_instances.Upload();
+      m_instancesDirty = false;
+    }
+    m_instances.Draw(m_palette);
+    return;
+  }
+
+  if (m_meshDirty) {
+    BuildMesh(m_mesh, m_meshMode);
+    m_mesh.Upload();
+    m_meshDirty = false;
+  }
+  m_mesh.Draw(m_palette);
+}
+
+// Metoda BuildMesh
+template <uint8_t Depth, uint8_t Width, uint16_t Height>
+void Chunk<Depth, Width, Height>::BuildMesh(ChunkMesh &mesh,
+                                            ChunkMesh::Mode mode) const {
+  mesh.Clear();
+  if (mode == ChunkMesh::Mode::Greedy) {
+    BuildGreedy(mesh);
+  } else {
+    BuildFaces(mesh);
+  }
+}
+
+// Metoda BuildInstances
+template <uint8_t Depth, uint8_t Width, uint16_t Height>
+void Chunk<Depth, Width, Height>::BuildInstances(
+    ChunkInstances &instances) const {
+  instances.Clear();
+  for (size_t y = 0; y < Height; ++y) {
+    // Sekcja bez odslonietych scian: przeskok do nastepnej
+    if (m_sections[y / s_sectionHeight].m_exposed == 0) {
+      y += s_sectionHeight - 1;
+      continue;
+    }
+    for (size_t x = 0; x < Width; ++x) {
+      const size_t row = RowIndex(x, y);
+      uint64_t visible = 0;
+      for (const Rows_t &faces : m_faces) {
+        visible |= faces[row];
+      }
+      for (; visible != 0; visible &= visible - 1) {
+        const size_t z = LowestBit(visible);
+        instances.Add(m_palette.Layer(GetType(z, x, y)), glm::vec3(x, y, z));
+      }
+    }
+  }
+}
+
+// Metoda SetMeshMode
+template <uint8_t Depth, uint8_t Width, uint16_t Height>
+void Chunk<Depth, Width, Height>::SetMeshMode(ChunkMesh::Mode mode) {
+  if (m_meshMode != mode) {
+    m_meshMode = mode;
+    m_meshDirty = true;
+  }
+}
 
-  for (size_t z = 0; z < Depth; ++z) {
+// Metoda BuildFaces
+template <uint8_t Depth, uint8_t Width, uint16_t Height>
+void Chunk<Depth, Width, Height>::BuildFaces(ChunkMesh &mesh) const {
+  size_t faceCount = 0;
+  for (size_t y = 0; y < Height; ++y) {
+    // Sekcja bez odslonietych scian: przeskok do nastepnej
+    if (m_sections[y / s_sectionHeight].m_exposed == 0) {
+      y += s_sectionHeight - 1;
+      continue;
+    }
     for (size_t x = 0; x < Width; ++x) {
-      for (size_t y = 0; y < Height; ++y) {
-        size_t index = CoordsToIndex(z, x, y);
+      for (const Rows_t &faces : m_faces) {
+        faceCount += BitCount(faces[RowIndex(x, y)]);
+      }
+    }
+  }
+  mesh.Reserve(faceCount);
 
-        if (m_data[index].m_isVisible) {
-          glm::mat4 model = glm::translate(glm::mat4(1.0f), glm::vec3(x, y, z));
-          shader.setMat4("model", model);
-          m_palette.LookUp(m_data[index].m_type).Draw();
+  for (size_t y = 0; y < Height; ++y) {
+    if (m_sections[y / s_sectionHeight].m_exposed == 0) {
+      y += s_sectionHeight - 1;
+      continue;
+    }
+    for (size_t x = 0; x < Width; ++x) {
+      const size_t row = RowIndex(x, y);
+      for (size_t face = 0; face < Cube::s_faceCount; ++face) {
+        for (uint64_t bits = m_faces[face][row]; bits != 0; bits &= bits - 1) {
+          const size_t z = LowestBit(bits);
+          mesh.AddFace(m_palette.Layer(GetType(z, x, y)), glm::vec3(x, y, z),
+                       static_cast<Cube::Face>(face));
         }
       }
     }
   }
 }
 
-// Metoda Hit
-template <uint8_t Depth, uint8_t Width, uint8_t Height>
+// Metoda Hit (3D-DDA, Amanatides-Woo)
+template <uint8_t Depth, uint8_t Width, uint16_t Height>
 Ray::HitType Chunk<Depth, Width, Height>::Hit(const Ray& ray, Ray::time_t min, Ray::time_t max, HitRecord& record) const {
-    AABB::HitRecord chunkRecord;
-    if (m_aabb.Hit(ray, min, max, chunkRecord) == Ray::HitType::Miss) {
+    TRACE_ZONE("Chunk::Hit");
+    // Wszystko w ukladzie chunk'a: komorka (x, y, z) to [x, x + 1] x [y, y + 1] x [z, z + 1]
+    const glm::vec3 origin = ray.Origin() - glm::vec3(m_origin.x, 0, m_origin.y);
+    const glm::vec3 direction = ray.Direction();
+    const glm::vec3 inverse = ray.InverseDirection();
+    const glm::ivec3 size(Width, Height, Depth);
+
+    // Przedzial czasu, w ktorym promien jest wewnatrz chunk'a (metoda slabow)
+    Ray::time_t entry = min;
+    Ray::time_t exit = max;
+    int axis = static_cast<int>(AABB::Axis::x);
+    for (int i = 0; i < 3; ++i) {
+        if (direction[i] == 0.0f) {
+            if (origin[i] < 0.0f || origin[i] > size[i]) {
+                return Ray::HitType::Miss;
+            }
+            continue;
+        }
+        Ray::time_t tNear = (0.0f - origin[i]) * inverse[i];
+        Ray::time_t tFar = (size[i] - origin[i]) * inverse[i];
+        if (tNear > tFar) {
+            std::swap(tNear, tFar);
+        }
+        if (tNear > entry) {
+            entry = tNear;
+            axis = i;
+        }
+        exit = std::min(exit, tFar);
+    }
+    if (entry > exit) {
         return Ray::HitType::Miss;
     }
 
-    glm::vec3 chunkOffset = glm::vec3(m_origin.x, 0, m_origin.y);
-
-    Ray::time_t closestTime = max;
-    bool hitDetected = false;
+    // Komorka startowa; clamp chroni przed bledem zaokraglenia na scianie chunk'a
+    const glm::vec3 start = origin + direction * entry;
+    glm::ivec3 cell;
+    glm::ivec3 step;
+    glm::vec3 next;  // Czas dojscia do kolejnej granicy komorki w kazdej osi
+    glm::vec3 delta; // Czas przejscia przez cala komorke w kazdej osi
+    for (int i = 0; i < 3; ++i) {
+        cell[i] = std::min(std::max(static_cast<int>(std::floor(start[i])), 0), size[i] - 1);
+        step[i] = direction[i] > 0.0f ? 1 : (direction[i] < 0.0f ? -1 : 0);
+        delta[i] = step[i] != 0 ? step[i] * inverse[i] : std::numeric_limits<float>::infinity();
+        next[i] = step[i] != 0
+            ? (cell[i] + (step[i] > 0 ? 1 : 0) - origin[i]) * inverse[i]
+            : std::numeric_limits<float>::infinity();
+    }
 
-    for (size_t z = 0; z < Depth; ++z) {
-        for (size_t x = 0; x < Width; ++x) {
-            for (size_t y = 0; y < Height; ++y) {
-                size_t index = CoordsToIndex(z, x, y);
-                if (!m_data[index].m_isVisible || m_data[index].m_type == Cube::Type::None) {
-                    continue;
+    while (true) {
+        // Pusta cegla: przeskok do jej wyjscia w jednym kroku, na najwyzszym
+        // pustym poziomie piramidy (niepusta cegla 2^3 oznacza niepuste wyzsze)
+        if (m_pyramid[BrickIndex(1, cell.z, cell.x, cell.y)] == Empty) {
+            glm::ivec3 low;
+            glm::ivec3 high;
+            const size_t section = cell.y / s_sectionHeight;
+            if (GetSectionState(section) == SectionState::Empty) {
+                // Pusta sekcja: cala warstwa 16 kostek jest jedna cegla
+                const int bottom = static_cast<int>(section * s_sectionHeight);
+                low = glm::ivec3(0, bottom, 0);
+                high = glm::ivec3(size.x, bottom + static_cast<int>(s_sectionHeight), size.z);
+            } else {
+                const bool empty4 = m_pyramid[BrickIndex(2, cell.z, cell.x, cell.y)] == Empty;
+                const bool empty8 = m_pyramid[BrickIndex(3, cell.z, cell.x, cell.y)] == Empty;
+                const int level = 1 + empty4 + (empty4 && empty8);
+                const int brick = 1 << level;
+                for (int i = 0; i < 3; ++i) {
+                    low[i] = cell[i] >> level << level;
+                    high[i] = std::min(low[i] + brick, size[i]);
                 }
+            }
 
-                glm::vec3 cubeMin = chunkOffset + glm::vec3(x, y, z);
-                glm::vec3 cubeMax = cubeMin + glm::vec3(1.0f); // Cubes are 1x1x1
-                AABB cubeAABB(cubeMin, cubeMax);
-
-                AABB::HitRecord cubeRecord;
-                if (cubeAABB.Hit(ray, min, closestTime, cubeRecord) == Ray::HitType::Hit) {
-                    closestTime = cubeRecord.m_time;
-                    record.m_cubeIndex = glm::ivec3(z, x, y);
-
-                    glm::ivec3 neighborOffset = glm::ivec3(0);
-                    if (cubeRecord.m_axis == AABB::Axis::x) {
-                        neighborOffset.x = (ray.Direction().x > 0) ? -1 : 1;
-                    } else if (cubeRecord.m_axis == AABB::Axis::y) {
-                        neighborOffset.y = (ray.Direction().y > 0) ? -1 : 1;
-                    } else if (cubeRecord.m_axis == AABB::Axis::z) {
-                        neighborOffset.z = (ray.Direction().z > 0) ? -1 : 1;
+            // Czas wyjscia z cegly: next to najblizsza granica komorki, dalej co delta
+            Ray::time_t leave = std::numeric_limits<float>::infinity();
+            for (int i = 0; i < 3; ++i) {
+                if (step[i] != 0) {
+                    const int cells = step[i] > 0 ? high[i] - cell[i] - 1 : cell[i] - low[i];
+                    const Ray::time_t t = next[i] + delta[i] * cells;
+                    if (t < leave) {
+                        leave = t;
+                        axis = i;
                     }
-                    record.m_neighbourIndex = record.m_cubeIndex + neighborOffset;
+                }
+            }
+            if (leave > exit) {
+                return Ray::HitType::Miss;
+            }
 
-                    hitDetected = true;
+            // Przesuniecie o tyle granic, ile promien minal do chwili wyjscia
+            for (int i = 0; i < 3; ++i) {
+                if (i == axis) {
+                    const int cells = step[i] > 0 ? high[i] - cell[i] : cell[i] - low[i] + 1;
+                    cell[i] += step[i] * cells;
+                    next[i] += delta[i] * cells;
+                } else if (next[i] < leave) {
+                    const int cells = std::min(static_cast<int>((leave - next[i]) * std::abs(direction[i])) + 1,
+                                               step[i] > 0 ? high[i] - 1 - cell[i] : cell[i] - low[i]);
+                    cell[i] += step[i] * cells;
+                    next[i] += delta[i] * cells;
                 }
             }
+            if (cell[axis] < 0 || cell[axis] >= size[axis]) {
+                return Ray::HitType::Miss;
+            }
+            continue;
+        }
+
+        if (IsSolid(cell.z, cell.x, cell.y)) {
+            // Sasiad to komorka, z ktorej promien wszedl (tam stawia sie nowa kostke)
+            glm::ivec3 previous = cell;
+            previous[axis] -= step[axis];
+            record.m_cubeIndex = glm::ivec3(cell.z, cell.x, cell.y);
+            record.m_neighbourIndex = glm::ivec3(previous.z, previous.x, previous.y);
+            return Ray::HitType::Hit;
         }
-    }
 
-    return hitDetected ? Ray::HitType::Hit : Ray::HitType::Miss;
+        axis = next.x < next.y ? (next.x < next.z ? 0 : 2) : (next.y < next.z ? 1 : 2);
+        if (next[axis] > exit) {
+            return Ray::HitType::Miss;
+        }
+        cell[axis] += step[axis];
+        if (cell[axis] < 0 || cell[axis] >= size[axis]) {
+            return Ray::HitType::Miss;
+        }
+        next[axis] += delta[axis];
+    }
 }
+
 // Metoda CoordsToIndex
-template <uint8_t Depth, uint8_t Width, uint8_t Height>
+template <uint8_t Depth, uint8_t Width, uint16_t Height>
 size_t Chunk<Depth, Width, Height>::CoordsToIndex(size_t depth, size_t width, size_t height) const {
-  return height * static_cast<size_t>(Depth) * static_cast<size_t>(Width) +
+  return (height % s_sectionHeight) * static_cast<size_t>(Depth) *
+             static_cast<size_t>(Width) +
          width * static_cast<size_t>(Depth) + depth;
 }
 
-// Metoda UpdateVisibility
-template <uint8_t Depth, uint8_t Width, uint8_t Height>
-void Chunk<Depth, Width, Height>::UpdateVisibility() {
-  for (size_t z = 0; z < Depth; ++z) {
+// Metoda BuildGreedy
+template <uint8_t Depth, uint8_t Width, uint16_t Height>
+void Chunk<Depth, Width, Height>::BuildGreedy(ChunkMesh &mesh) const {
+  std::vector<Cube::Type> mask;
+
+  for (size_t face = 0; face < Cube::s_faceCount; ++face) {
+    const Cube::Face cubeFace = static_cast<Cube::Face>(face);
+    const glm::ivec3 direction = Cube::FaceDirection(cubeFace);
+
+    // Tylko warstwy od pierwszej do ostatniej sekcji z takimi scianami
+    glm::ivec3 low(0);
+    glm::ivec3 high(Width, 0, Depth);
+    low.y = Height;
+    for (size_t section = 0; section < s_sectionCount; ++section) {
+      if (m_sections[section].m_exposed & Cube::FaceBit(cubeFace)) {
+        low.y = std::min(low.y, static_cast<int>(section * s_sectionHeight));
+        high.y = static_cast<int>((section + 1) * s_sectionHeight);
+      }
+    }
+    if (low.y >= high.y) {
+      continue;
+    }
+    const glm::ivec3 size = high - low;
+
+    // Os normalnej sciany i dwie osie lezace w jej plaszczyznie
+    const int normal = direction.x != 0 ? 0 : (direction.y != 0 ? 1 : 2);
+    const int u = (normal + 1) % 3;
+    const int v = (normal + 2) % 3;
+    mask.assign(static_cast<size_t>(size[u]) * size[v], Cube::Type::None);
+
+    for (int slice = 0; slice < size[normal]; ++slice) {
+      // Maska odslonietych scian w warstwie: typ kostki albo None
+      glm::ivec3 cell(0);
+      cell[normal] = low[normal] + slice;
+      // Warstwa poziomych scian w sekcji bez nich (maska zostaje pusta, bo
+      // laczenie zeruje kazde uzyte pole)
+      if (normal == 1 &&
+          !(m_sections[cell.y / s_sectionHeight].m_exposed & Cube::FaceBit(cubeFace))) {
+        continue;
+      }
+      for (int j = 0; j < size[v]; ++j) {
+        for (int i = 0; i < size[u]; ++i) {
+          cell[u] = low[u] + i;
+          cell[v] = low[v] + j;
+          const bool exposed =
+              (m_faces[face][RowIndex(cell.x, cell.y)] >> cell.z) & 1;
+          mask[j * size[u] + i] =
+              exposed ? GetType(cell.z, cell.x, cell.y)
+                      : Cube::Type::None;
+        }
+      }
+
+      // Zachlanne laczenie: najpierw wzdluz u, potem cale wiersze wzdluz v
+      for (int j = 0; j < size[v]; ++j) {
+        for (int i = 0; i < size[u];) {
+          const Cube::Type type = mask[j * size[u] + i];
+          if (type == Cube::Type::None) {
+            ++i;
+            continue;
+          }
+
+          int width = 1;
+          while (i + width < size[u] && mask[j * size[u] + i + width] == type) {
+            ++width;
+          }
+
+          int height = 1;
+          for (; j + height < size[v]; ++height) {
+            bool rowMatches = true;
+            for (int k = 0; k < width && rowMatches; ++k) {
+              rowMatches = mask[(j + height) * size[u] + i + k] == type;
+            }
+            if (!rowMatches) {
+              break;
+            }
+          }
+
+          for (int l = 0; l < height; ++l) {
+            for (int k = 0; k < width; ++k) {
+              mask[(j + l) * size[u] + i + k] = Cube::Type::None;
+            }
+          }
+
+          glm::ivec3 origin = low;
+          origin[normal] += slice;
+          origin[u] += i;
+          origin[v] += j;
+          glm::ivec3 extent(1);
+          extent[u] = width;
+          extent[v] = height;
+          mesh.AddFace(m_palette.Layer(type), glm::vec3(origin), cubeFace, extent);
+
+          i += width;
+        }
+      }
+    }
+  }
+}
+
+// Metoda IsSolid (poza chunk'iem zawsze pusto)
+template <uint8_t Depth, uint8_t Width, uint16_t Height>
+bool Chunk<Depth, Width, Height>::IsSolid(int depth, int width,
+                                          int height) const {
+  if (depth < 0 || depth >= Depth) {
+    return false;
+  }
+  return (OccupancyRow(width, height) >> depth) & 1;
+}
+
+// Metoda OccupancyRow
+template <uint8_t Depth, uint8_t Width, uint16_t Height>
+typename Chunk<Depth, Width, Height>::Row_t
+Chunk<Depth, Width, Height>::OccupancyRow(int width, int height) const {
+  if (width < 0 || width >= Width || height < 0 || height >= Height) {
+    return 0;
+  }
+  return m_occupancy[RowIndex(width, height)];
+}
+
+// Metoda GetType
+template <uint8_t Depth, uint8_t Width, uint16_t Height>
+Cube::Type Chunk<Depth, Width, Height>::GetType(size_t depth, size_t width,
+                                                size_t height) const {
+  return m_sections[height / s_sectionHeight].m_blocks.Get(
+      CoordsToIndex(depth, width, height));
+}
+
+// Metoda GetSectionState (sekcja jest jednolita, gdy nie trzyma indeksow;
+// BlockStorage wraca do tego stanu, gdy znika ostatnia kostka innego typu)
+template <uint8_t Depth, uint8_t Width, uint16_t Height>
+typename Chunk<Depth, Width, Height>::SectionState
+Chunk<Depth, Width, Height>::GetSectionState(size_t section) const {
+  const BlockStorage &blocks = m_sections[section].m_blocks;
+  if (blocks.BitsPerBlock() != 0) {
+    return SectionState::Mixed;
+  }
+  return blocks.Get(0) == Cube::Type::None ? SectionState::Empty
+                                           : SectionState::Uniform;
+}
+
+// Metoda MemoryUsage
+template <uint8_t Depth, uint8_t Width, uint16_t Height>
+size_t Chunk<Depth, Width, Height>::MemoryUsage() const {
+  size_t usage = sizeof(*this);
+  for (const Section &section : m_sections) {
+    usage += section.m_blocks.MemoryUsage();
+  }
+  return usage;
+}
+
+// Metoda SetBlock
+template <uint8_t Depth, uint8_t Width, uint16_t Height>
+void Chunk<Depth, Width, Height>::SetBlock(size_t depth, size_t width,
+                                           size_t height, Cube::Type type) {
+  m_sections[height / s_sectionHeight].m_blocks.Set(
+      CoordsToIndex(depth, width, height), type);
+
+  const Row_t bit = static_cast<Row_t>(Row_t(1) << depth);
+  Row_t &row = m_occupancy[RowIndex(width, height)];
+  row = type == Cube::Type::None ? static_cast<Row_t>(row & ~bit) : row | bit;
+}
+
+// Metoda BrickIndex
+template <uint8_t Depth, uint8_t Width, uint16_t Height>
+size_t Chunk<Depth, Width, Height>::BrickIndex(int level, size_t depth,
+                                               size_t width,
+                                               size_t height) const {
+  return s_brickOffsets[level] +
+         ((height >> level) * BricksAlong(Width, level) + (width >> level)) *
+             BricksAlong(Depth, level) +
+         (depth >> level);
+}
+
+// Metoda UpdateBrick (min/max zajetosci cegly liczone z rzedow)
+template <uint8_t Depth, uint8_t Width, uint16_t Height>
+void Chunk<Depth, Width, Height>::UpdateBrick(int level, size_t depth,
+                                              size_t width, size_t height) {
+  const size_t brick = size_t(1) << level;
+  const size_t z0 = depth >> level << level;
+  const size_t x0 = width >> level << level;
+  const size_t y0 = height >> level << level;
+  const Row_t mask =
+      static_cast<Row_t>(((uint64_t(1) << brick) - 1) << z0) & s_fullRow;
+
+  bool any = false;
+  bool all = true;
+  for (size_t y = y0; y < std::min(y0 + brick, size_t(Height)); ++y) {
+    for (size_t x = x0; x < std::min(x0 + brick, size_t(Width)); ++x) {
+      const Row_t bits = m_occupancy[RowIndex(x, y)] & mask;
+      any |= bits != 0;
+      all &= bits == mask;
+    }
+  }
+  m_pyramid[BrickIndex(level, depth, width, height)] =
+      all ? Full : (any ? Mixed : Empty);
+}
+
+// Metoda UpdatePyramid
+template <uint8_t Depth, uint8_t Width, uint16_t Height>
+void Chunk<Depth, Width, Height>::UpdatePyramid() {
+  for (int level = 1; level <= s_brickLevels; ++level) {
+    const size_t brick = size_t(1) << level;
+    for (size_t y = 0; y < Height; y += brick) {
+      // Cegly nie wychodza poza sekcje; w jednolitej sa puste albo pelne
+      const SectionState state = GetSectionState(y / s_sectionHeight);
+      for (size_t x = 0; x < Width; x += brick) {
+        for (size_t z = 0; z < Depth; z += brick) {
+          if (state == SectionState::Mixed) {
+            UpdateBrick(level, z, x, y);
+          } else {
+            m_pyramid[BrickIndex(level, z, x, y)] =
+                state == SectionState::Empty ? Empty : Full;
+          }
+        }
+      }
+    }
+  }
+}
+
+// Metoda UpdatePyramid (tylko cegly zawierajace zmieniona kostke)
+template <uint8_t Depth, uint8_t Width, uint16_t Height>
+void Chunk<Depth, Width, Height>::UpdatePyramid(size_t depth, size_t width,
+                                                size_t height) {
+  for (int level = 1; level <= s_brickLevels; ++level) {
+    UpdateBrick(level, depth, width, height);
+  }
+}
+
+// Metoda NeighbourRow
+template <uint8_t Depth, uint8_t Width, uint16_t Height>
+typename Chunk<Depth, Width, Height>::Row_t
+Chunk<Depth, Width, Height>::NeighbourRow(Cube::Face face, int width,
+                                          int height) const {
+  // Wsuwane bity i rzedy poza chunk'iem biora sie z brzegow sasiadow
+  // (pustych, gdy sasiada nie ma); nad i pod chunk'iem zawsze pusto
+  const auto border = [&](Cube::Face side) {
+    return m_borders[static_cast<size_t>(side)][height];
+  };
+  switch (face) {
+  case Cube::Face::Front:
+    return static_cast<Row_t>(
+        (OccupancyRow(width, height) >> 1) |
+        (((border(face) >> width) & 1) << (Depth - 1)));
+  case Cube::Face::Back:
+    return static_cast<Row_t>((OccupancyRow(width, height) << 1) |
+                              ((border(face) >> width) & 1));
+  case Cube::Face::Left:
+    return width > 0 ? OccupancyRow(width - 1, height)
+                     : static_cast<Row_t>(border(face));
+  case Cube::Face::Right:
+    return width + 1 < Width ? OccupancyRow(width + 1, height)
+                             : static_cast<Row_t>(border(face));
+  case Cube::Face::Bottom:
+    return OccupancyRow(width, height - 1);
+  case Cube::Face::Top:
+    return OccupancyRow(width, height + 1);
+  }
+  return 0;
+}
+
+// Metoda UpdateRowFaces
+template <uint8_t Depth, uint8_t Width, uint16_t Height>
+bool Chunk<Depth, Width, Height>::UpdateRowFaces(size_t width, size_t height) {
+  const int x = static_cast<int>(width);
+  const int y = static_cast<int>(height);
+  const Row_t row = OccupancyRow(x, y);
+
+  // Sciana jest odslonieta, gdy w sasiedniej komorce nie ma kostki
+  bool changed = false;
+  for (size_t face = 0; face < Cube::s_faceCount; ++face) {
+    changed |= SetRowFaces(face, width, height,
+                           row & static_cast<Row_t>(~NeighbourRow(
+                                     static_cast<Cube::Face>(face), x, y)));
+  }
+  return changed;
+}
+
+// Metoda SetRowFaces
+template <uint8_t Depth, uint8_t Width, uint16_t Height>
+bool Chunk<Depth, Width, Height>::SetRowFaces(size_t face, size_t width,
+                                              size_t height, Row_t faces) {
+  if (faces != 0) {
+    m_sections[height / s_sectionHeight].m_exposed |=
+        Cube::FaceBit(static_cast<Cube::Face>(face));
+  }
+  Row_t &current = m_faces[face][RowIndex(width, height)];
+  const bool changed = current != faces;
+  current = faces;
+  return changed;
+}
+
+// Metoda BorderSlice
+template <uint8_t Depth, uint8_t Width, uint16_t Height>
+uint64_t Chunk<Depth, Width, Height>::BorderSlice(Cube::Face side,
+                                                  size_t height) const {
+  switch (side) {
+  case Cube::Face::Left:
+    return m_occupancy[RowIndex(0, height)];
+  case Cube::Face::Right:
+    return m_occupancy[RowIndex(Width - 1, height)];
+  case Cube::Face::Front:
+  case Cube::Face::Back: {
+    const size_t depth = side == Cube::Face::Front ? Depth - 1 : 0;
+    uint64_t slice = 0;
     for (size_t x = 0; x < Width; ++x) {
-      for (size_t y = 0; y < Height; ++y) {
-        size_t index = CoordsToIndex(z, x, y);
+      slice |= uint64_t((m_occupancy[RowIndex(x, height)] >> depth) & 1) << x;
+    }
+    return slice;
+  }
+  default:
+    return 0;
+  }
+}
+
+// Metoda OnBorder
+template <uint8_t Depth, uint8_t Width, uint16_t Height>
+bool Chunk<Depth, Width, Height>::OnBorder(Cube::Face side, size_t depth,
+                                           size_t width) {
+  switch (side) {
+  case Cube::Face::Front:
+    return depth == Depth - 1;
+  case Cube::Face::Back:
+    return depth == 0;
+  case Cube::Face::Left:
+    return width == 0;
+  case Cube::Face::Right:
+    return width == Width - 1;
+  default:
+    return false;
+  }
+}
+
+// Metoda SetNeighbour (przelicza tylko sciany side: jedna kolumne rzedow dla
+// Left i Right, jeden bit kazdego rzedu dla Front i Back)
+template <uint8_t Depth, uint8_t Width, uint16_t Height>
+bool Chunk<Depth, Width, Height>::SetNeighbour(Cube::Face side,
+                                               const Chunk *neighbour) {
+  const size_t index = static_cast<size_t>(side);
+  if (index >= s_sideCount) {
+    return false;
+  }
+  std::array<uint64_t, Height> &border = m_borders[index];
+  for (size_t y = 0; y < Height; ++y) {
+    border[y] =
+        neighbour != nullptr ? neighbour->BorderSlice(Cube::Opposite(side), y) : 0;
+  }
 
-        if (m_data[index].m_type == Cube::Type::None) {
-          m_data[index].m_isVisible = false;
+  const bool column = side == Cube::Face::Left || side == Cube::Face::Right;
+  const size_t firstX = side == Cube::Face::Right ? Width - 1 : 0;
+  const size_t lastX = side == Cube::Face::Left ? 1 : Width;
+  bool changed = false;
+  for (size_t y = 0; y < Height; ++y) {
+    for (size_t x = column ? firstX : 0; x < (column ? lastX : Width); ++x) {
+      const int cellX = static_cast<int>(x);
+      const int cellY = static_cast<int>(y);
+      changed |= SetRowFaces(
+          index, x, y,
+          OccupancyRow(cellX, cellY) &
+              static_cast<Row_t>(~NeighbourRow(side, cellX, cellY)));
+    }
+  }
+  m_meshDirty |= changed;
+  m_instancesDirty |= changed;
+  return changed;
+}
+
+// Metoda UpdateBorder
+template <uint8_t Depth, uint8_t Width, uint16_t Height>
+bool Chunk<Depth, Width, Height>::UpdateBorder(Cube::Face side,
+                                               const Chunk *neighbour,
+                                               size_t column, size_t height) {
+  const size_t index = static_cast<size_t>(side);
+  if (index >= s_sideCount) {
+    return false;
+  }
+  uint64_t &border = m_borders[index][height];
+  size_t x = column;
+  switch (side) {
+  case Cube::Face::Left:
+  case Cube::Face::Right:
+    // Brzeg to jeden rzad sasiada wzdluz z
+    border = neighbour != nullptr
+                 ? neighbour->BorderSlice(Cube::Opposite(side), height)
+                 : 0;
+    x = side == Cube::Face::Right ? Width - 1 : 0;
+    break;
+  default: {
+    // Brzeg to bity wzdluz x; zmienia sie tylko bit column
+    const size_t depth = side == Cube::Face::Front ? 0 : Depth - 1;
+    const uint64_t bit =
+        neighbour != nullptr
+            ? (neighbour->m_occupancy[RowIndex(column, height)] >> depth) & 1
+            : 0;
+    border = (border & ~(uint64_t(1) << column)) | (bit << column);
+    break;
+  }
+  }
+
+  const int cellX = static_cast<int>(x);
+  const int cellY = static_cast<int>(height);
+  const bool changed = SetRowFaces(
+      index, x, height,
+      OccupancyRow(cellX, cellY) &
+          static_cast<Row_t>(~NeighbourRow(side, cellX, cellY)));
+  m_meshDirty |= changed;
+  m_instancesDirty |= changed;
+  return changed;
+}
+
+// Metoda UpdateVisibility
+template <uint8_t Depth, uint8_t Width, uint16_t Height>
+void Chunk<Depth, Width, Height>::UpdateVisibility() {
+  TRACE_ZONE("Chunk::UpdateVisibility");
+  for (size_t section = 0; section < s_sectionCount; ++section) {
+    const size_t y0 = section * s_sectionHeight;
+    m_sections[section].m_exposed = 0;
+    // Pusta sekcja nie ma scian
+    if (GetSectionState(section) == SectionState::Empty) {
+      for (Rows_t &faces : m_faces) {
+        std::fill(faces.begin() + RowIndex(0, y0),
+                  faces.begin() + RowIndex(0, y0 + s_sectionHeight), Row_t(0));
+      }
+      continue;
+    }
+    const bool uniform = GetSectionState(section) == SectionState::Uniform;
+    for (size_t y = y0; y < y0 + s_sectionHeight; ++y) {
+      for (size_t x = 0; x < Width; ++x) {
+        const bool inside = uniform && y > y0 && y + 1 < y0 + s_sectionHeight &&
+                            x > 0 && x + 1 < Width;
+        if (!inside) {
+          UpdateRowFaces(x, y);
           continue;
         }
-        bool isVisible = false;
-        if (z == 0 ||
-            m_data[CoordsToIndex(z - 1, x, y)].m_type == Cube::Type::None)
-          isVisible = true;
-        if (z == Depth - 1 ||
-            m_data[CoordsToIndex(z + 1, x, y)].m_type == Cube::Type::None)
-          isVisible = true;
-        if (x == 0 ||
-            m_data[CoordsToIndex(z, x - 1, y)].m_type == Cube::Type::None)
-          isVisible = true;
-        if (x == Width - 1 ||
-            m_data[CoordsToIndex(z, x + 1, y)].m_type == Cube::Type::None)
-          isVisible = true;
-        if (y == 0 ||
-            m_data[CoordsToIndex(z, x, y - 1)].m_type == Cube::Type::None)
-          isVisible = true;
-        if (y == Height - 1 ||
-            m_data[CoordsToIndex(z, x, y + 1)].m_type == Cube::Type::None)
-          isVisible = true;
-        m_data[index].m_isVisible = isVisible;
+        // Wnetrze pelnej sekcji: sasiednie rzedy sa pelne, odsloniete moga
+        // byc tylko skrajne bity przy brzegach Front i Back
+        const size_t index = RowIndex(x, y);
+        const auto exposed = [&](Cube::Face side, Row_t bit) {
+          const uint64_t border = m_borders[static_cast<size_t>(side)][y];
+          return ((border >> x) & 1) != 0 ? Row_t(0) : bit;
+        };
+        for (Rows_t &faces : m_faces) {
+          faces[index] = 0;
+        }
+        SetRowFaces(static_cast<size_t>(Cube::Face::Front), x, y,
+                    exposed(Cube::Face::Front, static_cast<Row_t>(Row_t(1) << (Depth - 1))));
+        SetRowFaces(static_cast<size_t>(Cube::Face::Back), x, y,
+                    exposed(Cube::Face::Back, Row_t(1)));
       }
     }
   }
+  m_meshDirty = true;
+  m_instancesDirty = true;
+}
+
+// Metoda UpdateVisibility (tylko zmieniona kostka i jej szesciu sasiadow)
+template <uint8_t Depth, uint8_t Width, uint16_t Height>
+bool Chunk<Depth, Width, Height>::UpdateVisibility(size_t /*depth*/,
+                                                   size_t width,
+                                                   size_t height) {
+  TRACE_ZONE("Chunk::UpdateVisibility(block)");
+  // Rzad kostki obejmuje tez sasiadow z -1 i z +1
+  bool changed = UpdateRowFaces(width, height);
+  if (width > 0) {
+    changed |= UpdateRowFaces(width - 1, height);
+  }
+  if (width + 1 < Width) {
+    changed |= UpdateRowFaces(width + 1, height);
+  }
+  if (height > 0) {
+    changed |= UpdateRowFaces(width, height - 1);
+  }
+  if (height + 1 < Height) {
+    changed |= UpdateRowFaces(width, height + 1);
+  }
+
+  // Siatka jest przebudowywana tylko wtedy, gdy ktoras sciana sie zmienila
+  m_meshDirty |= changed;
+  m_instancesDirty |= changed;
+  return changed;
 }
 
 // Metoda RemoveBlock
-template <uint8_t Depth, uint8_t Width, uint8_t Height>
+template <uint8_t Depth, uint8_t Width, uint16_t Height>
 bool Chunk<Depth, Width, Height>::RemoveBlock(uint8_t width, uint8_t height, uint8_t depth) {
-    size_t index = CoordsToIndex(depth, width, height);
-    if (m_data[index].m_type == Cube::Type::None)
+    if (!IsSolid(depth, width, height))
         return false;
-    m_data[index].m_type = Cube::Type::None;
-    UpdateVisibility();
+    SetBlock(depth, width, height, Cube::Type::None);
+    UpdateVisibility(depth, width, height);
+    UpdatePyramid(depth, width, height);
     return true;
 }
 
 // Eksportowanie szablonów
-template class Chunk<16, 16, 16>;
\ No newline at end of file
+template class Chunk<16, 16, 16>;
+template class Chunk<32, 32, 32>;
+template class Chunk<64, 64, 64>;
+template class Chunk<16, 16, 256>;
\ No newline at end of file
@@ -0,0 +1,98 @@
+#include "../include/ChunkInstances.hpp"
+#include "../include/RenderStats.hpp"
+#include "../include/GLState.hpp"
+#include "../include/CubeGeometry.hpp"
+
+#include <cstddef>
+#include <utility>
+
+namespace {
+
+// Atrybuty aOffset i aLayer w shaderze wierzcholkow
+constexpr GLuint s_offsetAttribute = 3;
+constexpr GLuint s_layerAttribute = 4;
+
+} // namespace
+
+ChunkInstances::ChunkInstances(ChunkInstances &&rhs) noexcept
+    : m_vbo(std::exchange(rhs.m_vbo, 0)),
+      m_instances(std::move(rhs.m_instances)),
+      m_count(std::exchange(rhs.m_count, 0)) {}
+
+ChunkInstances &ChunkInstances::operator=(ChunkInstances &&rhs) noexcept {
+  if (&rhs == this) {
+    return *this;
+  }
+
+  // Zwalnia wlasny bufor przed przejeciem cudzego
+  if (m_vbo != 0) {
+    GLState::DeleteBuffer(m_vbo);
+  }
+  m_vbo = std::exchange(rhs.m_vbo, 0);
+  m_instances = std::move(rhs.m_instances);
+  m_count = std::exchange(rhs.m_count, 0);
+
+  return *this;
+}
+
+ChunkInstances::~ChunkInstances() {
+  if (m_vbo == 0) {
+    return;
+  }
+  GLState::DeleteBuffer(m_vbo);
+}
+
+void ChunkInstances::Clear() {
+  m_instances.clear();
+  m_count = 0;
+}
+
+void ChunkInstances::Add(int layer, const glm::vec3 &offset) {
+  m_instances.push_back({offset, static_cast<GLfloat>(layer)});
+  ++m_count;
+}
+
+void ChunkInstances::Upload() {
+  if (m_vbo == 0) {
+    glGenBuffers(1, &m_vbo);
+  }
+
+  GLState::BindBuffer(GL_ARRAY_BUFFER, m_vbo);
+  glBufferData(GL_ARRAY_BUFFER, m_instances.size() * sizeof(Instance),
+               m_instances.data(), GL_STATIC_DRAW);
+  RenderStats::Add(RenderStats::Counter::BufferUploads);
+
+  m_instances.clear();
+}
+
+void ChunkInstances::Draw(const CubePalette &palette) const {
+  if (m_count == 0) {
+    return;
+  }
+
+  // VAO kostki jest wspolny dla wszystkich chunk'ow, wiec atrybuty instancji
+  // sa podpinane na czas rysowania i wylaczane na koncu
+  palette.Bind();
+  GLState::BindVertexArray(palette.Vao());
+  GLState::BindBuffer(GL_ARRAY_BUFFER, m_vbo);
+  glEnableVertexAttribArray(s_offsetAttribute);
+  glVertexAttribDivisor(s_offsetAttribute, 1);
+  glVertexAttribPointer(s_offsetAttribute, 3, GL_FLOAT, GL_FALSE,
+                        sizeof(Instance), (void *)offsetof(Instance, m_offset));
+  glEnableVertexAttribArray(s_layerAttribute);
+  glVertexAttribDivisor(s_layerAttribute, 1);
+  glVertexAttribPointer(s_layerAttribute, 1, GL_FLOAT, GL_FALSE,
+                        sizeof(Instance), (void *)offsetof(Instance, m_layer));
+
+  glDrawElementsInstanced(GL_TRIANGLES, CubeGeometry::s_indexCount,
+                          GL_UNSIGNED_INT, (void *)0,
+                          static_cast<GLsizei>(m_count));
+  RenderStats::Add(RenderStats::Counter::DrawCalls);
+  RenderStats::Add(RenderStats::Counter::Instances,
+                   static_cast<double>(m_count));
+  RenderStats::Add(RenderStats::Counter::Triangles,
+                   static_cast<double>(m_count * (CubeGeometry::s_indexCount / 3)));
+
+  glDisableVertexAttribArray(s_offsetAttribute);
+  glDisableVertexAttribArray(s_layerAttribute);
+}
@@ -0,0 +1,148 @@
+#include "../include/ChunkMesh.hpp"
+#include "../include/RenderStats.hpp"
+#include "../include/GLState.hpp"
+
+#include <cstddef>
+#include <utility>
+
+ChunkMesh::ChunkMesh(ChunkMesh &&rhs) noexcept
+    : m_vbo(std::exchange(rhs.m_vbo, 0)), m_vao(std::exchange(rhs.m_vao, 0)),
+      m_ebo(std::exchange(rhs.m_ebo, 0)),
+      m_vertices(std::move(rhs.m_vertices)),
+      m_indices(std::move(rhs.m_indices)),
+      m_indexCount(std::exchange(rhs.m_indexCount, 0)) {}
+
+ChunkMesh &ChunkMesh::operator=(ChunkMesh &&rhs) noexcept {
+  if (&rhs == this) {
+    return *this;
+  }
+
+  // Zwalnia wlasne obiekty GL przed przejeciem cudzych
+  if (m_vao != 0) {
+    GLState::DeleteBuffer(m_vbo);
+    GLState::DeleteBuffer(m_ebo);
+    GLState::DeleteVertexArray(m_vao);
+  }
+  m_vbo = std::exchange(rhs.m_vbo, 0);
+  m_vao = std::exchange(rhs.m_vao, 0);
+  m_ebo = std::exchange(rhs.m_ebo, 0);
+  m_vertices = std::move(rhs.m_vertices);
+  m_indices = std::move(rhs.m_indices);
+  m_indexCount = std::exchange(rhs.m_indexCount, 0);
+
+  return *this;
+}
+
+ChunkMesh::~ChunkMesh() {
+  // Mesh moze nigdy nie trafic na GPU (np. chunk bez kontekstu GL)
+  if (m_vao == 0) {
+    return;
+  }
+  GLState::DeleteBuffer(m_vbo);
+  GLState::DeleteBuffer(m_ebo);
+  GLState::DeleteVertexArray(m_vao);
+}
+
+void ChunkMesh::Clear() {
+  m_vertices.clear();
+  m_indices.clear();
+  m_indexCount = 0;
+}
+
+void ChunkMesh::Reserve(size_t faceCount) {
+  m_vertices.reserve(faceCount * 4);
+  m_indices.reserve(faceCount * 6);
+}
+
+void ChunkMesh::AddFace(int layer, const glm::vec3 &offset,
+                        Cube::Face face, const glm::ivec3 &extent) {
+  const std::array<Cube::Corner, 4> corners = Cube::FaceCorners(face);
+
+  // Osie, wzdluz ktorych rosna u i v: rogi 0-1 i 1-2 roznia sie jedna osia
+  auto changedAxis = [](const glm::vec3 &a, const glm::vec3 &b) {
+    return a.x != b.x ? 0 : (a.y != b.y ? 1 : 2);
+  };
+  const int axis01 = changedAxis(corners[0].m_position, corners[1].m_position);
+  const int axis12 = changedAxis(corners[1].m_position, corners[2].m_position);
+  const bool uAlong01 = corners[0].m_texCoord.x != corners[1].m_texCoord.x;
+  const glm::vec2 repeat(extent[uAlong01 ? axis01 : axis12],
+                         extent[uAlong01 ? axis12 : axis01]);
+
+  std::array<Vertex, 4> quad;
+  for (size_t i = 0; i < quad.size(); ++i) {
+    for (int axis = 0; axis < 3; ++axis) {
+      const float corner = corners[i].m_position[axis];
+      quad[i].m_position[axis] =
+          offset[axis] + (corner < 0.0f ? corner : corner + extent[axis] - 1);
+    }
+    quad[i].m_texCoord = corners[i].m_texCoord * repeat;
+    quad[i].m_tile = corners[i].m_tile;
+    quad[i].m_layer = static_cast<GLfloat>(layer);
+  }
+  AddQuad(quad);
+}
+
+void ChunkMesh::AddQuad(const std::array<Vertex, 4> &quad) {
+  const GLuint first = static_cast<GLuint>(m_vertices.size());
+  m_vertices.insert(m_vertices.end(), quad.begin(), quad.end());
+
+  for (GLuint corner : {0u, 1u, 2u, 2u, 3u, 0u}) {
+    m_indices.push_back(first + corner);
+  }
+  m_indexCount += 6;
+}
+
+void ChunkMesh::Upload() {
+  if (m_vao == 0) {
+    glGenVertexArrays(1, &m_vao);
+    glGenBuffers(1, &m_vbo);
+    glGenBuffers(1, &m_ebo);
+
+    GLState::BindVertexArray(m_vao);
+    GLState::BindBuffer(GL_ARRAY_BUFFER, m_vbo);
+    GLState::BindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_ebo);
+
+    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex),
+                          (void *)offsetof(Vertex, m_position)); // Pozycja
+    glEnableVertexAttribArray(0);
+
+    glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, sizeof(Vertex),
+                          (void *)offsetof(Vertex, m_texCoord)); // Tekstura
+    glEnableVertexAttribArray(1);
+
+    glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, sizeof(Vertex),
+                          (void *)offsetof(Vertex, m_tile)); // Kafelek
+    glEnableVertexAttribArray(2);
+
+    glVertexAttribPointer(4, 1, GL_FLOAT, GL_FALSE, sizeof(Vertex),
+                          (void *)offsetof(Vertex, m_layer)); // Warstwa
+    glEnableVertexAttribArray(4);
+  } else {
+    GLState::BindVertexArray(m_vao);
+    GLState::BindBuffer(GL_ARRAY_BUFFER, m_vbo);
+  }
+
+  glBufferData(GL_ARRAY_BUFFER, m_vertices.size() * sizeof(Vertex),
+               m_vertices.data(), GL_STATIC_DRAW);
+  glBufferData(GL_ELEMENT_ARRAY_BUFFER, m_indices.size() * sizeof(GLuint),
+               m_indices.data(), GL_STATIC_DRAW);
+  RenderStats::Add(RenderStats::Counter::BufferUploads, 2);
+
+  m_vertices.clear();
+  m_indices.clear();
+}
+
+void ChunkMesh::Draw(const CubePalette &palette) const {
+  if (m_indexCount == 0) {
+    return;
+  }
+  palette.Bind();
+  GLState::BindVertexArray(m_vao);
+  glDrawElements(GL_TRIANGLES, static_cast<GLsizei>(m_indexCount),
+                 GL_UNSIGNED_INT, (void *)0);
+  RenderStats::Add(RenderStats::Counter::DrawCalls);
+  RenderStats::Add(RenderStats::Counter::Triangles,
+                   static_cast<double>(TriangleCount()));
+}
+
+size_t ChunkMesh::TriangleCount() const { return m_indexCount / 3; }
@@ -2,8 +2,10 @@
 
 
 #include "../include/Cube.hpp"
-#include <SFML/Graphics.hpp>
-#include <iostream>
+#include "../include/RenderStats.hpp"
+#include "../include/GLState.hpp"
+#include "../include/CubeGeometry.hpp"
+#include <cmath>
 #include <utility>
 
 std::array<float, 6 * 6 * 5> Cube::s_vertices = {
@@ -69,94 +71,56 @@ std::array<float, 6 * 6 * 5> Cube::s_vertices = {
     -0.5f, 0.5f, -0.5f, 0.5f, 1.0f / 3.0f
     };
 
-Cube::Cube(Cube &&rhs) noexcept
-    : m_vbo(std::exchange(rhs.m_vbo, 0)), m_vao(std::exchange(rhs.m_vao, 0)),
-      m_texture(std::exchange(rhs.m_texture, 0)) {}
-
-
-Cube &Cube::operator=(Cube &&rhs) noexcept {
-  if (&rhs == this) {
-    return *this;
+std::array<Cube::Corner, 4> Cube::FaceCorners(Face face) {
+  // Each face in s_vertices is two triangles (v0, v1, v2) and (v2, v4, v0)
+  static constexpr std::array<size_t, 4> s_cornerVertices = {0, 1, 2, 4};
+  const size_t first = static_cast<size_t>(face) * 6;
+
+  std::array<Corner, 4> corners;
+  glm::vec2 tile(1.0f);
+  for (size_t i = 0; i < corners.size(); ++i) {
+    const float *vertex = &s_vertices[(first + s_cornerVertices[i]) * 5];
+    corners[i].m_position = glm::vec3(vertex[0], vertex[1], vertex[2]);
+    corners[i].m_texCoord = glm::vec2(vertex[3], vertex[4]);
+    tile = glm::min(tile, corners[i].m_texCoord);
   }
 
-  m_vbo = std::exchange(rhs.m_vbo, 0);
-  m_vao = std::exchange(rhs.m_vao, 0);
-  m_texture = std::exchange(rhs.m_texture, 0);
-
-  return *this;
-
-}
-
-Cube::Cube(const std::string &texturePath) {
-  m_texture = CreateTexture(texturePath);
-
-  glGenVertexArrays(1, &m_vao);
-  glGenBuffers(1, &m_vbo);
-
-  glBindVertexArray(m_vao);
-
-
-  glBindBuffer(GL_ARRAY_BUFFER, m_vbo);
-  glBufferData(GL_ARRAY_BUFFER, s_vertices.size() * sizeof(float),
-               s_vertices.data(), GL_STATIC_DRAW);
-
-  glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 5 * sizeof(float),
-
-                        (void *)0); // Pozycja
-  glEnableVertexAttribArray(0);
-
-  glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, 5 * sizeof(float),
-
-                        (void *)(3 * sizeof(float))); // Tekstura
-
-  glEnableVertexAttribArray(1);
-
-  glBindVertexArray(0);
-}
-
-Cube::~Cube() {
-  glDeleteBuffers(1, &m_vbo);
-  glDeleteBuffers(1, &m_ebo);
-  glDeleteVertexArrays(1, &m_vao);
-  glDeleteTextures(1, &m_texture);
-
+  for (Corner &corner : corners) {
+    const glm::vec2 local = corner.m_texCoord - tile;
+    corner.m_texCoord = glm::vec2(std::round(local.x / s_tileWidth),
+                                  std::round(local.y / s_tileHeight));
+    corner.m_tile = tile;
+  }
+  return corners;
 }
 
-GLuint Cube::CreateTexture(const std::string &texturePath) {
-  sf::Image image;
-  if (!image.loadFromFile(texturePath)) {
-    std::cerr << "Failed to load texture from: " << texturePath << std::endl;
-    return 0;
+glm::ivec3 Cube::FaceDirection(Face face) {
+  switch (face) {
+  case Face::Front:
+    return glm::ivec3(0, 0, 1);
+  case Face::Back:
+    return glm::ivec3(0, 0, -1);
+  case Face::Left:
+    return glm::ivec3(-1, 0, 0);
+  case Face::Right:
+    return glm::ivec3(1, 0, 0);
+  case Face::Bottom:
+    return glm::ivec3(0, -1, 0);
+  case Face::Top:
+    return glm::ivec3(0, 1, 0);
   }
-
-  image.flipVertically();
-
-
-  GLuint texture;
-  glGenTextures(1, &texture);
-  glBindTexture(GL_TEXTURE_2D, texture);
-
-  glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, image.getSize().x, image.getSize().y,
-               0, GL_RGBA, GL_UNSIGNED_BYTE, image.getPixelsPtr());
-
-  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
-  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
-
-  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER,
-                  GL_NEAREST_MIPMAP_LINEAR);
-  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
-
-  glGenerateMipmap(GL_TEXTURE_2D);
-
-  glBindTexture(GL_TEXTURE_2D, 0);
-
-  return texture;
+  return glm::ivec3(0);
 }
 
+Cube::Cube(Type type, int layer, GLuint vao)
+    : m_vao(vao), m_type(type), m_layer(layer) {}
 
 void Cube::Draw() const {
-  glBindVertexArray(m_vao);
-  glBindTexture(GL_TEXTURE_2D, m_texture);
-  glDrawArrays(GL_TRIANGLES, 0, 36);
-  glBindVertexArray(0);
+  GLState::BindVertexArray(m_vao);
+  // Atrybut warstwy nie jest wlaczony w VAO kostki, wiec ma stala wartosc
+  glVertexAttrib1f(4, static_cast<GLfloat>(m_layer));
+  glDrawElements(GL_TRIANGLES, CubeGeometry::s_indexCount, GL_UNSIGNED_INT, (void *)0);
+  RenderStats::Add(RenderStats::Counter::DrawCalls);
+  RenderStats::Add(RenderStats::Counter::Triangles,
+                   CubeGeometry::s_indexCount / 3);
 }
@@ -0,0 +1,85 @@
+#include "../include/CubeGeometry.hpp"
+#include "../include/GLState.hpp"
+#include "../include/Cube.hpp"
+
+#include <array>
+#include <utility>
+
+CubeGeometry::CubeGeometry() {
+  // Ten sam uklad wierzcholkow co ChunkMesh: pozycja, kafelek uv, rog kafelka
+  std::array<float, s_vertexCount * 7> vertices;
+  std::array<GLuint, s_indexCount> indices;
+  size_t offset = 0;
+  size_t index = 0;
+  for (size_t face = 0; face < Cube::s_faceCount; ++face) {
+    const std::array<Cube::Corner, 4> corners =
+        Cube::FaceCorners(static_cast<Cube::Face>(face));
+    for (const Cube::Corner &c : corners) {
+      for (float value : {c.m_position.x, c.m_position.y, c.m_position.z,
+                          c.m_texCoord.x, c.m_texCoord.y, c.m_tile.x,
+                          c.m_tile.y}) {
+        vertices[offset++] = value;
+      }
+    }
+    const GLuint first = static_cast<GLuint>(face * corners.size());
+    for (GLuint corner : {0u, 1u, 2u, 2u, 3u, 0u}) {
+      indices[index++] = first + corner;
+    }
+  }
+
+  glGenVertexArrays(1, &m_vao);
+  glGenBuffers(1, &m_vbo);
+  glGenBuffers(1, &m_ebo);
+
+  GLState::BindVertexArray(m_vao);
+
+  GLState::BindBuffer(GL_ARRAY_BUFFER, m_vbo);
+  glBufferData(GL_ARRAY_BUFFER, vertices.size() * sizeof(float),
+               vertices.data(), GL_STATIC_DRAW);
+  GLState::BindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_ebo);
+  glBufferData(GL_ELEMENT_ARRAY_BUFFER, indices.size() * sizeof(GLuint),
+               indices.data(), GL_STATIC_DRAW);
+
+  glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 7 * sizeof(float),
+                        (void *)0); // Pozycja
+  glEnableVertexAttribArray(0);
+
+  glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, 7 * sizeof(float),
+                        (void *)(3 * sizeof(float))); // Tekstura
+  glEnableVertexAttribArray(1);
+
+  glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, 7 * sizeof(float),
+                        (void *)(5 * sizeof(float))); // Kafelek
+  glEnableVertexAttribArray(2);
+}
+
+CubeGeometry::CubeGeometry(CubeGeometry &&rhs) noexcept
+    : m_vbo(std::exchange(rhs.m_vbo, 0)), m_ebo(std::exchange(rhs.m_ebo, 0)),
+      m_vao(std::exchange(rhs.m_vao, 0)) {}
+
+CubeGeometry &CubeGeometry::operator=(CubeGeometry &&rhs) noexcept {
+  if (&rhs == this) {
+    return *this;
+  }
+
+  // Zwalnia wlasne obiekty GL przed przejeciem cudzych
+  if (m_vao != 0) {
+    GLState::DeleteBuffer(m_vbo);
+    GLState::DeleteBuffer(m_ebo);
+    GLState::DeleteVertexArray(m_vao);
+  }
+  m_vbo = std::exchange(rhs.m_vbo, 0);
+  m_ebo = std::exchange(rhs.m_ebo, 0);
+  m_vao = std::exchange(rhs.m_vao, 0);
+
+  return *this;
+}
+
+CubeGeometry::~CubeGeometry() {
+  if (m_vao == 0) {
+    return;
+  }
+  GLState::DeleteBuffer(m_vbo);
+  GLState::DeleteBuffer(m_ebo);
+  GLState::DeleteVertexArray(m_vao);
+}
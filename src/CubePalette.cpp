@@ -24,15 +24,81 @@ std::optional<std::string> FindTexture(const std::string &textureName) {
 
 
 #include "../include/CubePalette.hpp"
+#include "../include/GLState.hpp"
+#include "../include/Trace.hpp"
+#include <SFML/Graphics.hpp>
+#include <iostream>
+
 CubePalette::CubePalette() {
-  Cube grass("grass.jpg");
-  Cube stone("stone.jpg");
-  m_palette.insert(
-      std::pair<Cube::Type, Cube>(Cube::Type::Stone, std::move(stone)));
-  m_palette.insert(
-      std::pair<Cube::Type, Cube>(Cube::Type::Grass, std::move(grass)));
+  TRACE_ZONE("CubePalette::CubePalette");
+  // Kolejnosc plikow to numery warstw
+  const std::vector<std::pair<Cube::Type, std::string>> textures = {
+      {Cube::Type::Grass, "grass.jpg"}, {Cube::Type::Stone, "stone.jpg"}};
+
+  std::vector<std::string> paths;
+  for (const auto &texture : textures) {
+    m_palette.insert(std::pair<Cube::Type, Cube>(
+        texture.first, Cube(texture.first, static_cast<int>(paths.size()),
+                            m_geometry.Vao())));
+    paths.push_back(texture.second);
+  }
+  m_texture = CreateTexture(paths);
 }
+
+CubePalette::~CubePalette() { GLState::DeleteTexture(m_texture); }
+
 const Cube &CubePalette::LookUp(Cube::Type type) const {
 
   return m_palette.at(type);
-}
\ No newline at end of file
+}
+
+void CubePalette::Bind() const {
+  GLState::ActiveTexture(GL_TEXTURE0);
+  GLState::BindTexture(GL_TEXTURE_2D_ARRAY, m_texture);
+}
+
+GLuint CubePalette::CreateTexture(const std::vector<std::string> &texturePaths) {
+  std::vector<sf::Image> images(texturePaths.size());
+  for (size_t i = 0; i < texturePaths.size(); ++i) {
+    if (!images[i].loadFromFile(texturePaths[i])) {
+      std::cerr << "Failed to load texture from: " << texturePaths[i]
+                << std::endl;
+    }
+    images[i].flipVertically();
+  }
+  if (images.empty()) {
+    return 0;
+  }
+
+  const sf::Vector2u size = images.front().getSize();
+  GLuint texture;
+  glGenTextures(1, &texture);
+  GLState::BindTexture(GL_TEXTURE_2D_ARRAY, texture);
+
+  glTexImage3D(GL_TEXTURE_2D_ARRAY, 0, GL_RGBA, size.x, size.y,
+               static_cast<GLsizei>(images.size()), 0, GL_RGBA,
+               GL_UNSIGNED_BYTE, nullptr);
+  for (size_t i = 0; i < images.size(); ++i) {
+    // Warstwa o innym rozmiarze zostaje pusta (tablica ma jeden rozmiar)
+    if (images[i].getSize() != size) {
+      std::cerr << "Texture " << texturePaths[i] << " is "
+                << images[i].getSize().x << "x" << images[i].getSize().y
+                << ", expected " << size.x << "x" << size.y << std::endl;
+      continue;
+    }
+    glTexSubImage3D(GL_TEXTURE_2D_ARRAY, 0, 0, 0, static_cast<GLint>(i), size.x,
+                    size.y, 1, GL_RGBA, GL_UNSIGNED_BYTE,
+                    images[i].getPixelsPtr());
+  }
+
+  glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_S, GL_REPEAT);
+  glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_T, GL_REPEAT);
+
+  glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MIN_FILTER,
+                  GL_NEAREST_MIPMAP_LINEAR);
+  glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+
+  glGenerateMipmap(GL_TEXTURE_2D_ARRAY);
+
+  return texture;
+}
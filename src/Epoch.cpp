@@ -0,0 +1,132 @@
+#include "../include/Epoch.hpp"
+
+#include <array>
+#include <cstdlib>
+#include <iostream>
+#include <limits>
+#include <mutex>
+#include <vector>
+
+// Wszystkie operacje na epokach sa seq_cst: czytelnik publikuje epoke przed
+// odczytem wskaznika, a pisarz podbija epoke po podmianie wskaznika i dopiero
+// potem przeglada sloty, wiec nie moze przeoczyc czytelnika ze starym
+// wskaznikiem.
+struct Epoch::Domain {
+  struct Retired {
+    void *m_object;
+    void (*m_deleter)(void *);
+    // Czytelnicy z epoka <= m_epoch mogli widziec obiekt
+    uint64_t m_epoch;
+  };
+
+  // Zwalnia slot, gdy watek sie konczy
+  struct Owner {
+    Slot *m_slot{nullptr};
+    size_t m_depth{0};
+
+    ~Owner() {
+      if (m_slot != nullptr) {
+        m_slot->m_epoch.store(0);
+        m_slot->m_claimed.store(false);
+      }
+    }
+  };
+
+  // Powyzej tylu oczekujacych Retire sam wywoluje odzyskiwanie
+  static constexpr size_t s_reclaimThreshold = 64;
+
+  std::atomic<uint64_t> m_epoch{1};
+  std::array<Slot, s_maxThreads> m_slots;
+  std::mutex m_mutex;
+  std::vector<Retired> m_retired;
+};
+
+Epoch::Domain &Epoch::GetDomain() {
+  static Domain domain;
+  return domain;
+}
+
+Epoch::Slot &Epoch::ThreadSlot(size_t *&depth) {
+  thread_local Domain::Owner owner;
+  if (owner.m_slot == nullptr) {
+    for (Slot &slot : GetDomain().m_slots) {
+      bool claimed = false;
+      if (slot.m_claimed.compare_exchange_strong(claimed, true)) {
+        owner.m_slot = &slot;
+        break;
+      }
+    }
+    if (owner.m_slot == nullptr) {
+      std::cerr << "Epoch: more than " << s_maxThreads << " threads"
+                << std::endl;
+      std::abort();
+    }
+  }
+  depth = &owner.m_depth;
+  return *owner.m_slot;
+}
+
+Epoch::Guard::Guard() {
+  size_t *depth = nullptr;
+  Slot &slot = ThreadSlot(depth);
+  // Zagniezdzona sekcja zostaje przy epoce zewnetrznej
+  if ((*depth)++ == 0) {
+    slot.m_epoch.store(GetDomain().m_epoch.load());
+  }
+}
+
+Epoch::Guard::~Guard() {
+  size_t *depth = nullptr;
+  Slot &slot = ThreadSlot(depth);
+  if (--(*depth) == 0) {
+    slot.m_epoch.store(0);
+  }
+}
+
+uint64_t Epoch::OldestReader() {
+  uint64_t oldest = std::numeric_limits<uint64_t>::max();
+  for (const Slot &slot : GetDomain().m_slots) {
+    const uint64_t epoch = slot.m_epoch.load();
+    if (epoch != 0 && epoch < oldest) {
+      oldest = epoch;
+    }
+  }
+  return oldest;
+}
+
+void Epoch::Retire(void *object, void (*deleter)(void *)) {
+  Domain &domain = GetDomain();
+  std::lock_guard<std::mutex> lock(domain.m_mutex);
+  domain.m_retired.push_back({object, deleter, domain.m_epoch.fetch_add(1)});
+  if (domain.m_retired.size() > Domain::s_reclaimThreshold) {
+    ReclaimLocked(domain);
+  }
+}
+
+size_t Epoch::Reclaim() {
+  Domain &domain = GetDomain();
+  std::lock_guard<std::mutex> lock(domain.m_mutex);
+  return ReclaimLocked(domain);
+}
+
+size_t Epoch::ReclaimLocked(Domain &domain) {
+  const uint64_t oldest = OldestReader();
+  std::vector<Domain::Retired> kept;
+  size_t freed = 0;
+  for (const Domain::Retired &retired : domain.m_retired) {
+    if (retired.m_epoch < oldest) {
+      retired.m_deleter(retired.m_object);
+      ++freed;
+    } else {
+      kept.push_back(retired);
+    }
+  }
+  domain.m_retired.swap(kept);
+  return freed;
+}
+
+size_t Epoch::Pending() {
+  Domain &domain = GetDomain();
+  std::lock_guard<std::mutex> lock(domain.m_mutex);
+  return domain.m_retired.size();
+}
@@ -0,0 +1,60 @@
+#include "../include/Framebuffer.hpp"
+
+#include <utility>
+
+Framebuffer::Framebuffer(GLsizei width, GLsizei height)
+    : m_width(width), m_height(height) {
+  glGenFramebuffers(1, &m_fbo);
+  glBindFramebuffer(GL_FRAMEBUFFER, m_fbo);
+
+  glGenRenderbuffers(1, &m_color);
+  glBindRenderbuffer(GL_RENDERBUFFER, m_color);
+  glRenderbufferStorage(GL_RENDERBUFFER, GL_RGBA8, width, height);
+  glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0,
+                            GL_RENDERBUFFER, m_color);
+
+  glGenRenderbuffers(1, &m_depth);
+  glBindRenderbuffer(GL_RENDERBUFFER, m_depth);
+  glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH24_STENCIL8, width, height);
+  glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_STENCIL_ATTACHMENT,
+                            GL_RENDERBUFFER, m_depth);
+
+  m_complete =
+      glCheckFramebufferStatus(GL_FRAMEBUFFER) == GL_FRAMEBUFFER_COMPLETE;
+  glBindRenderbuffer(GL_RENDERBUFFER, 0);
+}
+
+Framebuffer::Framebuffer(Framebuffer &&rhs) noexcept
+    : m_fbo(std::exchange(rhs.m_fbo, 0)),
+      m_color(std::exchange(rhs.m_color, 0)),
+      m_depth(std::exchange(rhs.m_depth, 0)), m_width(rhs.m_width),
+      m_height(rhs.m_height), m_complete(std::exchange(rhs.m_complete, false)) {}
+
+Framebuffer &Framebuffer::operator=(Framebuffer &&rhs) noexcept {
+  if (&rhs == this) {
+    return *this;
+  }
+
+  m_fbo = std::exchange(rhs.m_fbo, 0);
+  m_color = std::exchange(rhs.m_color, 0);
+  m_depth = std::exchange(rhs.m_depth, 0);
+  m_width = rhs.m_width;
+  m_height = rhs.m_height;
+  m_complete = std::exchange(rhs.m_complete, false);
+
+  return *this;
+}
+
+Framebuffer::~Framebuffer() {
+  if (m_fbo == 0) {
+    return;
+  }
+  glDeleteRenderbuffers(1, &m_color);
+  glDeleteRenderbuffers(1, &m_depth);
+  glDeleteFramebuffers(1, &m_fbo);
+}
+
+void Framebuffer::Bind() const {
+  glBindFramebuffer(GL_FRAMEBUFFER, m_fbo);
+  glViewport(0, 0, m_width, m_height);
+}
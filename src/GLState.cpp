@@ -0,0 +1,148 @@
+#include "../include/GLState.hpp"
+
+GLState::State::State() {
+  for (auto &unit : m_textures) {
+    unit.fill(s_unknown);
+  }
+}
+
+GLState::State &GLState::Current() {
+  // Jeden kontekst GL na watek
+  thread_local State state;
+  return state;
+}
+
+bool GLState::Change(GLuint &cached, GLuint value) {
+  State &state = Current();
+  if (cached == value) {
+    ++state.m_frame.m_skipped;
+    return false;
+  }
+  cached = value;
+  ++state.m_frame.m_issued;
+  return true;
+}
+
+GLuint *GLState::CachedBuffer(GLenum target) {
+  switch (target) {
+  case GL_ARRAY_BUFFER:
+    return &Current().m_arrayBuffer;
+  case GL_UNIFORM_BUFFER:
+    return &Current().m_uniformBuffer;
+  default:
+    return nullptr;
+  }
+}
+
+GLuint *GLState::CachedTexture(GLenum target) {
+  State &state = Current();
+  const size_t unit = state.m_activeUnit - GL_TEXTURE0;
+  if (state.m_activeUnit == s_unknown || unit >= s_textureUnits) {
+    return nullptr;
+  }
+  switch (target) {
+  case GL_TEXTURE_2D:
+    return &state.m_textures[unit][0];
+  case GL_TEXTURE_2D_ARRAY:
+    return &state.m_textures[unit][1];
+  default:
+    return nullptr;
+  }
+}
+
+void GLState::UseProgram(GLuint program) {
+  if (Change(Current().m_program, program)) {
+    glUseProgram(program);
+  }
+}
+
+void GLState::BindVertexArray(GLuint vao) {
+  if (Change(Current().m_vao, vao)) {
+    glBindVertexArray(vao);
+  }
+}
+
+void GLState::BindBuffer(GLenum target, GLuint buffer) {
+  GLuint *cached = CachedBuffer(target);
+  if (cached == nullptr) {
+    ++Current().m_frame.m_issued;
+    glBindBuffer(target, buffer);
+  } else if (Change(*cached, buffer)) {
+    glBindBuffer(target, buffer);
+  }
+}
+
+void GLState::ActiveTexture(GLenum unit) {
+  if (Change(Current().m_activeUnit, unit)) {
+    glActiveTexture(unit);
+  }
+}
+
+void GLState::BindTexture(GLenum target, GLuint texture) {
+  GLuint *cached = CachedTexture(target);
+  if (cached == nullptr) {
+    ++Current().m_frame.m_issued;
+    glBindTexture(target, texture);
+  } else if (Change(*cached, texture)) {
+    glBindTexture(target, texture);
+  }
+}
+
+// Usuniety program pozostaje aktywny az do zmiany, a jego nazwa moze wrocic
+// z glCreateProgram, wiec cache traci pewnosc
+void GLState::DeleteProgram(GLuint program) {
+  State &state = Current();
+  if (state.m_program == program) {
+    state.m_program = s_unknown;
+  }
+  glDeleteProgram(program);
+}
+
+// Usuniecie zwiazanego obiektu przywraca wiazanie 0
+void GLState::DeleteVertexArray(GLuint vao) {
+  State &state = Current();
+  if (state.m_vao == vao) {
+    state.m_vao = 0;
+  }
+  glDeleteVertexArrays(1, &vao);
+}
+
+void GLState::DeleteBuffer(GLuint buffer) {
+  State &state = Current();
+  for (GLuint *cached : {&state.m_arrayBuffer, &state.m_uniformBuffer}) {
+    if (*cached == buffer) {
+      *cached = 0;
+    }
+  }
+  glDeleteBuffers(1, &buffer);
+}
+
+void GLState::DeleteTexture(GLuint texture) {
+  // Po usunieciu wiazanie wraca do 0, ale nie trzeba zgadywac na ktorych jednostkach
+  State &state = Current();
+  for (auto &unit : state.m_textures) {
+    for (GLuint &cached : unit) {
+      if (cached == texture) {
+        cached = s_unknown;
+      }
+    }
+  }
+  glDeleteTextures(1, &texture);
+}
+
+void GLState::Invalidate() {
+  State &state = Current();
+  const Counters frame = state.m_frame;
+  const Counters lastFrame = state.m_lastFrame;
+  state = State();
+  state.m_frame = frame;
+  state.m_lastFrame = lastFrame;
+}
+
+void GLState::EndFrame() {
+  State &state = Current();
+  state.m_lastFrame = state.m_frame;
+  state.m_frame = Counters();
+}
+
+GLState::Counters GLState::LastFrame() { return Current().m_lastFrame; }
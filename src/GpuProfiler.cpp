@@ -0,0 +1,142 @@
+#include "../include/GpuProfiler.hpp"
+#include "../include/RenderStats.hpp"
+
+#include <algorithm>
+
+namespace {
+double Milliseconds(std::chrono::steady_clock::duration duration) {
+  return std::chrono::duration<double, std::milli>(duration).count();
+}
+} // namespace
+
+double GpuProfiler::Timings::CpuTotal() const {
+  double total = 0.0;
+  for (double time : m_cpu) {
+    total += time;
+  }
+  return total;
+}
+
+double GpuProfiler::Timings::GpuTotal() const {
+  double total = 0.0;
+  for (double time : m_gpu) {
+    total += time;
+  }
+  return total;
+}
+
+double GpuProfiler::Timings::CpuSubmit() const {
+  return CpuTotal() - m_cpu[static_cast<size_t>(Pass::Present)];
+}
+
+GpuProfiler::GpuProfiler() {
+  for (Slot &slot : m_slots) {
+    glGenQueries(static_cast<GLsizei>(slot.m_queries.size()),
+                 slot.m_queries.data());
+  }
+}
+
+GpuProfiler::~GpuProfiler() {
+  for (Slot &slot : m_slots) {
+    glDeleteQueries(static_cast<GLsizei>(slot.m_queries.size()),
+                    slot.m_queries.data());
+  }
+}
+
+void GpuProfiler::BeginFrame() {
+  Slot &slot = m_slots[m_frame % s_frames];
+  // Wynik sprzed s_frames klatek nadal niegotowy: przepada zamiast czekac
+  if (slot.m_pending) {
+    ++m_dropped;
+  }
+  slot.m_issued = 0;
+  slot.m_lastQuery = 0;
+  slot.m_frame = m_frame;
+  slot.m_pending = false;
+}
+
+void GpuProfiler::Begin(Pass pass) { Mark(pass, 0); }
+
+void GpuProfiler::End(Pass pass) { Mark(pass, 1); }
+
+void GpuProfiler::Mark(Pass pass, size_t end) {
+  Slot &slot = m_slots[m_frame % s_frames];
+  const size_t index = 2 * static_cast<size_t>(pass) + end;
+  slot.m_cpu[index] = Clock::now();
+  glQueryCounter(slot.m_queries[index], GL_TIMESTAMP);
+  slot.m_issued |= 1u << index;
+  slot.m_lastQuery = slot.m_queries[index];
+}
+
+void GpuProfiler::EndFrame() {
+  Slot &current = m_slots[m_frame % s_frames];
+  current.m_pending = current.m_issued != 0;
+
+  // Zapytania koncza sie w kolejnosci wyslania, wiec odczyt zatrzymuje sie na
+  // pierwszej niegotowej klatce
+  const size_t first = m_frame + 1 >= s_frames ? m_frame + 1 - s_frames : 0;
+  m_oldest = std::max(m_oldest, first);
+  bool resolved = false;
+  for (; m_oldest <= m_frame; ++m_oldest) {
+    Slot &slot = m_slots[m_oldest % s_frames];
+    if (!slot.m_pending || slot.m_frame != m_oldest) {
+      continue;
+    }
+    if (!Resolve(slot)) {
+      break;
+    }
+    resolved = true;
+  }
+  ++m_frame;
+
+  // Czasy CPU i GPU z tej samej klatki, tylko gdy odczytano nowa; bez tego
+  // RenderStats nie ma probki w tej klatce (zamiast powtorzonej starej)
+  if (resolved) {
+    RenderStats::Add(RenderStats::Counter::GpuTime, m_latest.GpuTotal());
+    RenderStats::Add(RenderStats::Counter::CpuSubmitTime, m_latest.CpuSubmit());
+  }
+}
+
+bool GpuProfiler::Resolve(Slot &slot) {
+  GLuint available = GL_FALSE;
+  glGetQueryObjectuiv(slot.m_lastQuery, GL_QUERY_RESULT_AVAILABLE, &available);
+  if (available == GL_FALSE) {
+    return false;
+  }
+
+  Timings timings;
+  timings.m_frame = slot.m_frame;
+  for (size_t pass = 0; pass < s_passCount; ++pass) {
+    const uint32_t both = 3u << (2 * pass);
+    if ((slot.m_issued & both) != both) {
+      continue;
+    }
+    GLuint64 begin = 0;
+    GLuint64 end = 0;
+    glGetQueryObjectui64v(slot.m_queries[2 * pass], GL_QUERY_RESULT, &begin);
+    glGetQueryObjectui64v(slot.m_queries[2 * pass + 1], GL_QUERY_RESULT, &end);
+    // Znaczniki GPU sa w nanosekundach
+    timings.m_gpu[pass] = static_cast<double>(end - begin) / 1e6;
+    timings.m_cpu[pass] =
+        Milliseconds(slot.m_cpu[2 * pass + 1] - slot.m_cpu[2 * pass]);
+  }
+  timings.m_valid = true;
+
+  m_latest = timings;
+  slot.m_pending = false;
+  return true;
+}
+
+const char *GpuProfiler::Name(Pass pass) {
+  switch (pass) {
+  case Pass::Clear:
+    return "clear";
+  case Pass::Draw:
+    return "draw";
+  case Pass::Present:
+    return "present";
+  case Pass::Count:
+    break;
+  }
+  return "unknown";
+}
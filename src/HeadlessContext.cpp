@@ -0,0 +1,136 @@
+#include "../include/HeadlessContext.hpp"
+
+#include <glad/glad.h>
+
+#ifdef MAJNKRAFT_EGL
+#include <EGL/egl.h>
+#include <EGL/eglext.h>
+#else
+#include <SFML/Window/Context.hpp>
+#include <SFML/Window/ContextSettings.hpp>
+#endif
+
+#include <iostream>
+
+#ifdef MAJNKRAFT_EGL
+
+struct HeadlessContext::Backend {
+  EGLDisplay m_display{EGL_NO_DISPLAY};
+  EGLContext m_context{EGL_NO_CONTEXT};
+
+  ~Backend() {
+    if (m_display == EGL_NO_DISPLAY) {
+      return;
+    }
+    eglMakeCurrent(m_display, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
+    if (m_context != EGL_NO_CONTEXT) {
+      eglDestroyContext(m_display, m_context);
+    }
+    eglTerminate(m_display);
+  }
+
+  bool Create() {
+    // Platforma surfaceless Mesy nie potrzebuje ani X, ani DRM
+    const auto getPlatformDisplay =
+        reinterpret_cast<PFNEGLGETPLATFORMDISPLAYEXTPROC>(
+            eglGetProcAddress("eglGetPlatformDisplayEXT"));
+    if (getPlatformDisplay != nullptr) {
+      m_display = getPlatformDisplay(EGL_PLATFORM_SURFACELESS_MESA,
+                                     EGL_DEFAULT_DISPLAY, nullptr);
+    }
+    if (m_display == EGL_NO_DISPLAY) {
+      m_display = eglGetDisplay(EGL_DEFAULT_DISPLAY);
+    }
+    EGLint major = 0;
+    EGLint minor = 0;
+    if (m_display == EGL_NO_DISPLAY ||
+        eglInitialize(m_display, &major, &minor) != EGL_TRUE) {
+      std::cerr << "Failed to initialize EGL display" << std::endl;
+      m_display = EGL_NO_DISPLAY;
+      return false;
+    }
+
+    if (eglBindAPI(EGL_OPENGL_API) != EGL_TRUE) {
+      std::cerr << "EGL has no desktop OpenGL" << std::endl;
+      return false;
+    }
+
+    // Rysowanie idzie do FBO, wiec konfiguracja nie potrzebuje okna
+    const EGLint configAttributes[] = {EGL_SURFACE_TYPE, EGL_PBUFFER_BIT,
+                                       EGL_RENDERABLE_TYPE, EGL_OPENGL_BIT,
+                                       EGL_NONE};
+    EGLConfig config;
+    EGLint configCount = 0;
+    if (eglChooseConfig(m_display, configAttributes, &config, 1,
+                        &configCount) != EGL_TRUE ||
+        configCount == 0) {
+      std::cerr << "No EGL config with OpenGL support" << std::endl;
+      return false;
+    }
+
+    const EGLint contextAttributes[] = {
+        EGL_CONTEXT_MAJOR_VERSION_KHR, 3,
+        EGL_CONTEXT_MINOR_VERSION_KHR, 3,
+        EGL_CONTEXT_OPENGL_PROFILE_MASK_KHR,
+        EGL_CONTEXT_OPENGL_CORE_PROFILE_BIT_KHR,
+        EGL_NONE};
+    m_context =
+        eglCreateContext(m_display, config, EGL_NO_CONTEXT, contextAttributes);
+    if (m_context == EGL_NO_CONTEXT) {
+      std::cerr << "Failed to create OpenGL 3.3 core EGL context" << std::endl;
+      return false;
+    }
+
+    // Bez powierzchni (EGL_KHR_surfaceless_context)
+    if (eglMakeCurrent(m_display, EGL_NO_SURFACE, EGL_NO_SURFACE,
+                       m_context) != EGL_TRUE) {
+      std::cerr << "Failed to make EGL context current" << std::endl;
+      return false;
+    }
+    return gladLoadGLLoader((GLADloadproc)eglGetProcAddress) != 0;
+  }
+};
+
+#else
+
+struct HeadlessContext::Backend {
+  sf::Context m_context;
+
+  // sf::Context bez okna ma wlasny, niewidoczny bufor; rozmiar jest bez
+  // znaczenia, bo rysowanie idzie do FBO
+  Backend() : m_context(Settings(), 1, 1) {}
+
+  static sf::ContextSettings Settings() {
+    sf::ContextSettings settings;
+    settings.depthBits = 24;
+    settings.stencilBits = 8;
+    settings.majorVersion = 3;
+    settings.minorVersion = 3;
+    settings.attributeFlags = sf::ContextSettings::Core;
+    return settings;
+  }
+
+  bool Create() {
+    return m_context.setActive(true) &&
+           gladLoadGLLoader((GLADloadproc)sf::Context::getFunction) != 0;
+  }
+};
+
+#endif
+
+HeadlessContext::HeadlessContext() : m_backend(std::make_unique<Backend>()) {
+  m_valid = m_backend->Create();
+  if (!m_valid) {
+    std::cerr << "Failed to initialize OpenGL context" << std::endl;
+  }
+}
+
+HeadlessContext::~HeadlessContext() = default;
+
+std::string HeadlessContext::Renderer() const {
+  if (!m_valid) {
+    return "";
+  }
+  const GLubyte *renderer = glGetString(GL_RENDERER);
+  return renderer != nullptr ? reinterpret_cast<const char *>(renderer) : "";
+}
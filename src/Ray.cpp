@@ -1,8 +1,12 @@
 #include "Ray.hpp"
 
+#include <cmath>
+
 Ray::Ray(const glm::vec3& origin, const glm::vec3& direction)
 	: m_origin(origin)
-	, m_direction(direction) {
+	, m_direction(direction)
+	, m_inverseDirection(1.0f / direction.x, 1.0f / direction.y, 1.0f / direction.z)
+	, m_signMask(static_cast<uint8_t>(std::signbit(direction.x) | std::signbit(direction.y) << 1 | std::signbit(direction.z) << 2)) {
 }
 
 glm::vec3 Ray::At(Ray::time_t t) const {
@@ -0,0 +1,266 @@
+#include "../include/RenderBenchmark.hpp"
+#include "../include/Camera.hpp"
+#include "../include/CameraBuffer.hpp"
+#include "../include/CameraPath.hpp"
+#include "../include/Chunk.hpp"
+#include "../include/CubePalette.hpp"
+#include "../include/Framebuffer.hpp"
+#include "../include/GpuProfiler.hpp"
+#include "../include/HeadlessContext.hpp"
+#include "../include/RenderStats.hpp"
+#include "../include/ShaderProgram.hpp"
+
+#include <glad/glad.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace {
+
+struct Distribution {
+  double m_min{0.0};
+  double m_avg{0.0};
+  double m_p50{0.0};
+  double m_p90{0.0};
+  double m_p99{0.0};
+  double m_max{0.0};
+};
+
+// Percentyle metoda najblizszego rangu, jak w RenderStats
+Distribution Describe(std::vector<double> samples) {
+  Distribution distribution;
+  if (samples.empty()) {
+    return distribution;
+  }
+  std::sort(samples.begin(), samples.end());
+  auto percentile = [&](size_t percent) {
+    const size_t rank = (samples.size() * percent + 99) / 100;
+    return samples[std::max<size_t>(rank, 1) - 1];
+  };
+
+  double sum = 0.0;
+  for (double sample : samples) {
+    sum += sample;
+  }
+  distribution.m_min = samples.front();
+  distribution.m_avg = sum / static_cast<double>(samples.size());
+  distribution.m_p50 = percentile(50);
+  distribution.m_p90 = percentile(90);
+  distribution.m_p99 = percentile(99);
+  distribution.m_max = samples.back();
+  return distribution;
+}
+
+void WriteDistribution(std::ostream &stream, const char *name,
+                       const std::vector<double> &samples) {
+  const Distribution distribution = Describe(samples);
+  stream << "\"" << name << "\":{\"min\":" << distribution.m_min
+         << ",\"avg\":" << distribution.m_avg
+         << ",\"p50\":" << distribution.m_p50
+         << ",\"p90\":" << distribution.m_p90
+         << ",\"p99\":" << distribution.m_p99
+         << ",\"max\":" << distribution.m_max << "}";
+}
+
+std::string Escape(const std::string &text) {
+  std::string escaped;
+  for (char c : text) {
+    if (c == '"' || c == '\\') {
+      escaped += '\\';
+    }
+    escaped += c;
+  }
+  return escaped;
+}
+
+} // namespace
+
+std::optional<RenderBenchmark::Options>
+RenderBenchmark::Parse(int argc, char *argv[], int first) {
+  Options options;
+  for (int i = first; i < argc; ++i) {
+    const std::string argument = argv[i];
+    if (i + 1 >= argc) {
+      std::cerr << "Missing value for " << argument << std::endl;
+      return std::nullopt;
+    }
+    const std::string value = argv[++i];
+    if (argument == "--out") {
+      options.m_output = value;
+    } else if (argument == "--path") {
+      options.m_cameraPath = value;
+    } else if (argument == "--size") {
+      const size_t separator = value.find('x');
+      if (separator == std::string::npos) {
+        std::cerr << "Expected <width>x<height>, got " << value << std::endl;
+        return std::nullopt;
+      }
+      options.m_width = std::atoi(value.substr(0, separator).c_str());
+      options.m_height = std::atoi(value.substr(separator + 1).c_str());
+      if (options.m_width <= 0 || options.m_height <= 0) {
+        std::cerr << "Invalid size " << value << std::endl;
+        return std::nullopt;
+      }
+    } else {
+      std::cerr << "Unknown option " << argument << std::endl;
+      return std::nullopt;
+    }
+  }
+  return options;
+}
+
+int RenderBenchmark::Run(const Options &options) {
+  HeadlessContext context;
+  if (!context.Valid()) {
+    return -1;
+  }
+
+  Framebuffer framebuffer(options.m_width, options.m_height);
+  if (!framebuffer.Complete()) {
+    std::cerr << "Offscreen framebuffer is incomplete" << std::endl;
+    return -1;
+  }
+  framebuffer.Bind();
+  glEnable(GL_DEPTH_TEST);
+
+  ShaderProgram shaders;
+  if (shaders.getProgramId() == 0) {
+    std::cerr << "Failed to create shader program" << std::endl;
+    return -1;
+  }
+  CameraBuffer cameraBuffer;
+  CubePalette palette;
+
+  using Chunk_t = Chunk<16, 16, 16>;
+  std::vector<std::unique_ptr<Chunk_t>> chunks;
+  for (int z = 0; z < s_gridSize; ++z) {
+    for (int x = 0; x < s_gridSize; ++x) {
+      chunks.push_back(
+          std::make_unique<Chunk_t>(glm::vec2(x * 16, z * 16), palette));
+      chunks.back()->Generate();
+    }
+  }
+  // Sciany miedzy sasiednimi chunk'ami sa zasloniete
+  for (int z = 0; z < s_gridSize; ++z) {
+    for (int x = 0; x < s_gridSize; ++x) {
+      Chunk_t &chunk = *chunks[z * s_gridSize + x];
+      if (x > 0) {
+        chunk.SetNeighbour(Cube::Face::Left, chunks[z * s_gridSize + x - 1].get());
+      }
+      if (x + 1 < s_gridSize) {
+        chunk.SetNeighbour(Cube::Face::Right, chunks[z * s_gridSize + x + 1].get());
+      }
+      if (z > 0) {
+        chunk.SetNeighbour(Cube::Face::Back, chunks[(z - 1) * s_gridSize + x].get());
+      }
+      if (z + 1 < s_gridSize) {
+        chunk.SetNeighbour(Cube::Face::Front, chunks[(z + 1) * s_gridSize + x].get());
+      }
+    }
+  }
+
+  const float worldSize = static_cast<float>(s_gridSize * 16);
+  CameraPath path = CameraPath::Orbit(
+      glm::vec3(worldSize / 2.0f, 16.0f, worldSize / 2.0f), worldSize / 2.0f,
+      24.0f, 20.0f);
+  if (!options.m_cameraPath.empty()) {
+    std::optional<CameraPath> loaded = CameraPath::Load(options.m_cameraPath);
+    if (!loaded) {
+      return -1;
+    }
+    path = std::move(*loaded);
+  }
+
+  Camera camera(glm::vec3(0.0f), glm::vec3(0.0f, 0.0f, -1.0f), -90.0f, 0.0f);
+  camera.SetAspectRatio(static_cast<float>(options.m_width) /
+                        static_cast<float>(options.m_height));
+  GpuProfiler profiler;
+
+  const size_t frames =
+      static_cast<size_t>(std::ceil(path.Duration() / options.m_step)) + 1;
+  std::vector<double> frameTimes;
+  std::vector<double> gpuTimes;
+  std::vector<double> drawCalls;
+  std::vector<double> triangles;
+  // Czas GPU przychodzi z opoznieniem kilku klatek; kazda zmierzona klatka
+  // profilera trafia do gpuTimes raz, wedlug jej wlasnego numeru
+  size_t nextGpuFrame = options.m_warmupFrames;
+
+  // Rozgrzewka (budowa siatek, pierwsze uzycie tekstur) przed pomiarem
+  for (size_t frame = 0; frame < options.m_warmupFrames + frames; ++frame) {
+    const size_t pathFrame =
+        frame < options.m_warmupFrames ? 0 : frame - options.m_warmupFrames;
+    path.Apply(static_cast<float>(pathFrame) * options.m_step, camera);
+
+    const auto start = std::chrono::steady_clock::now();
+    profiler.BeginFrame();
+
+    profiler.Begin(GpuProfiler::Pass::Clear);
+    glClearColor(0.2f, 0.3f, 0.3f, 1.0f);
+    glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+    profiler.End(GpuProfiler::Pass::Clear);
+
+    profiler.Begin(GpuProfiler::Pass::Draw);
+    cameraBuffer.Update(camera);
+    for (const std::unique_ptr<Chunk_t> &chunk : chunks) {
+      chunk->Draw(shaders);
+    }
+    profiler.End(GpuProfiler::Pass::Draw);
+
+    // Bez wymiany buforow klatka konczy sie, gdy GPU skonczy rysowac
+    profiler.Begin(GpuProfiler::Pass::Present);
+    glFinish();
+    profiler.End(GpuProfiler::Pass::Present);
+
+    profiler.EndFrame();
+    const std::chrono::duration<double, std::milli> elapsed =
+        std::chrono::steady_clock::now() - start;
+    RenderStats::EndFrame(elapsed.count());
+
+    if (frame < options.m_warmupFrames) {
+      continue;
+    }
+    frameTimes.push_back(elapsed.count());
+    drawCalls.push_back(
+        RenderStats::Summarize(RenderStats::Counter::DrawCalls).m_last);
+    triangles.push_back(
+        RenderStats::Summarize(RenderStats::Counter::Triangles).m_last);
+    const GpuProfiler::Timings &gpu = profiler.Latest();
+    if (gpu.m_valid && gpu.m_frame >= nextGpuFrame) {
+      gpuTimes.push_back(gpu.GpuTotal());
+      nextGpuFrame = gpu.m_frame + 1;
+    }
+  }
+
+  std::ofstream file(options.m_output);
+  if (!file) {
+    std::cerr << "Failed to write " << options.m_output << std::endl;
+    return -1;
+  }
+  file << "{\"renderer\":\"" << Escape(context.Renderer()) << "\""
+       << ",\"width\":" << options.m_width << ",\"height\":" << options.m_height
+       << ",\"chunks\":" << chunks.size() << ",\"frames\":" << frameTimes.size()
+       << ",";
+  WriteDistribution(file, "frame_ms", frameTimes);
+  file << ",";
+  WriteDistribution(file, "gpu_ms", gpuTimes);
+  file << ",";
+  WriteDistribution(file, "draw_calls", drawCalls);
+  file << ",";
+  WriteDistribution(file, "triangles", triangles);
+  file << "}\n";
+
+  const Distribution frameTime = Describe(frameTimes);
+  std::cout << context.Renderer() << ": " << frameTimes.size()
+            << " frames, frame ms p50 " << frameTime.m_p50 << " p99 "
+            << frameTime.m_p99 << " max " << frameTime.m_max << " -> "
+            << options.m_output << std::endl;
+  return file ? 0 : -1;
+}
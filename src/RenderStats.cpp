@@ -0,0 +1,152 @@
+#include "../include/RenderStats.hpp"
+#include "../include/GLState.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <iostream>
+#include <limits>
+#include <vector>
+
+RenderStats::State &RenderStats::Current() {
+  // Jak GLState: jeden kontekst (i jedna klatka) na watek
+  thread_local State state;
+  return state;
+}
+
+void RenderStats::Add(Counter counter, double value) {
+  State &state = Current();
+  state.m_current[static_cast<size_t>(counter)] += value;
+  state.m_added[static_cast<size_t>(counter)] = true;
+}
+
+bool RenderStats::Sparse(Counter counter) {
+  return counter == Counter::GpuTime || counter == Counter::CpuSubmitTime;
+}
+
+void RenderStats::EndFrame(double frameMilliseconds) {
+  GLState::EndFrame();
+  const GLState::Counters binds = GLState::LastFrame();
+
+  State &state = Current();
+  state.m_current[static_cast<size_t>(Counter::FrameTime)] = frameMilliseconds;
+  state.m_current[static_cast<size_t>(Counter::Binds)] =
+      static_cast<double>(binds.m_issued);
+  state.m_current[static_cast<size_t>(Counter::SkippedBinds)] =
+      static_cast<double>(binds.m_skipped);
+
+  const size_t slot = state.m_frames % s_window;
+  for (size_t i = 0; i < s_counterCount; ++i) {
+    state.m_samples[i][slot] =
+        Sparse(static_cast<Counter>(i)) && !state.m_added[i]
+            ? std::numeric_limits<double>::quiet_NaN()
+            : state.m_current[i];
+  }
+  state.m_current.fill(0.0);
+  state.m_added.fill(false);
+  ++state.m_frames;
+
+  if (state.m_writeEvery != 0 && state.m_frames % state.m_writeEvery == 0) {
+    Write(state.m_path);
+  }
+}
+
+RenderStats::Summary RenderStats::Summarize(Counter counter) {
+  const State &state = Current();
+  const size_t count = std::min(state.m_frames, s_window);
+  if (count == 0) {
+    return Summary();
+  }
+
+  const auto &samples = state.m_samples[static_cast<size_t>(counter)];
+  std::vector<double> sorted;
+  sorted.reserve(count);
+  double last = 0.0;
+  // Od najstarszej do najnowszej, bez klatek bez probki
+  for (size_t i = state.m_frames - count; i < state.m_frames; ++i) {
+    const double value = samples[i % s_window];
+    if (!std::isnan(value)) {
+      sorted.push_back(value);
+      last = value;
+    }
+  }
+  if (sorted.empty()) {
+    return Summary();
+  }
+  std::sort(sorted.begin(), sorted.end());
+
+  Summary summary;
+  summary.m_min = sorted.front();
+  summary.m_max = sorted.back();
+  double sum = 0.0;
+  for (double value : sorted) {
+    sum += value;
+  }
+  summary.m_avg = sum / static_cast<double>(sorted.size());
+  // Najblizszy rang: najmniejsza wartosc, od ktorej 99% probek nie jest wieksze
+  const size_t rank = (sorted.size() * 99 + 99) / 100;
+  summary.m_p99 = sorted[std::max<size_t>(rank, 1) - 1];
+  summary.m_last = last;
+  return summary;
+}
+
+const char *RenderStats::Name(Counter counter) {
+  switch (counter) {
+  case Counter::FrameTime:
+    return "frame_ms";
+  case Counter::GpuTime:
+    return "gpu_ms";
+  case Counter::CpuSubmitTime:
+    return "cpu_submit_ms";
+  case Counter::DrawCalls:
+    return "draw_calls";
+  case Counter::Triangles:
+    return "triangles";
+  case Counter::Instances:
+    return "instances";
+  case Counter::Chunks:
+    return "chunks";
+  case Counter::Binds:
+    return "binds";
+  case Counter::SkippedBinds:
+    return "skipped_binds";
+  case Counter::UniformUploads:
+    return "uniform_uploads";
+  case Counter::BufferUploads:
+    return "buffer_uploads";
+  case Counter::Count:
+    break;
+  }
+  return "unknown";
+}
+
+size_t RenderStats::Frames() { return Current().m_frames; }
+
+bool RenderStats::Write(const std::string &path) {
+  std::ofstream file(path, std::ios::app);
+  if (!file) {
+    std::cerr << "Failed to open render stats file: " << path << std::endl;
+    return false;
+  }
+
+  const State &state = Current();
+  file << "{\"frame\":" << state.m_frames
+       << ",\"window\":" << std::min(state.m_frames, s_window)
+       << ",\"counters\":{";
+  for (size_t i = 0; i < s_counterCount; ++i) {
+    const Counter counter = static_cast<Counter>(i);
+    const Summary summary = Summarize(counter);
+    file << (i == 0 ? "" : ",") << "\"" << Name(counter) << "\":{"
+         << "\"min\":" << summary.m_min << ",\"avg\":" << summary.m_avg
+         << ",\"p99\":" << summary.m_p99 << ",\"max\":" << summary.m_max
+         << ",\"last\":" << summary.m_last << "}";
+  }
+  file << "}}\n";
+  return static_cast<bool>(file);
+}
+
+void RenderStats::WriteEvery(const std::string &path, size_t frames) {
+  State &state = Current();
+  state.m_path = path;
+  state.m_writeEvery = frames;
+}
@@ -2,23 +2,44 @@
 
 
 #include "../include/ShaderProgram.hpp"
+#include "../include/RenderStats.hpp"
+#include "../include/GLState.hpp"
+#include "../include/CameraBuffer.hpp"
+#include "../include/Trace.hpp"
 #include <iostream>
+#include <vector>
 
 std::string ShaderProgram::s_vertexShaderSource = R"(
     #version 330 core
     layout (location = 0) in vec3 aPos;
     layout (location = 1) in vec2 aTexCoord;
+    layout (location = 2) in vec2 aTile;
+    // Przesuniecie instancji kostki; poza rysowaniem instancji atrybut jest
+    // wylaczony i ma wartosc domyslna (0, 0, 0)
+    layout (location = 3) in vec3 aOffset;
+    // Warstwa tablicy tekstur (typ kostki)
+    layout (location = 4) in float aLayer;
 
     out vec2 TexCoord;
+    out vec2 Tile;
+    flat out float Layer;
 
 
+    // Wspolny dla wszystkich programow, zob. CameraBuffer
+    layout (std140) uniform Camera {
+        mat4 view;
+        mat4 projection;
+        mat4 viewProjection;
+        vec4 cameraPosition;
+    };
+
     uniform mat4 model;
-    uniform mat4 view;
-    uniform mat4 projection;
 
     void main() {
-        gl_Position = projection * view * model *vec4(aPos, 1.0);
+        gl_Position = viewProjection * model * vec4(aPos + aOffset, 1.0);
         TexCoord = aTexCoord;
+        Tile = aTile;
+        Layer = aLayer;
     })";
 
 std::string ShaderProgram::s_fragmentShaderSource = R"(
@@ -27,16 +48,25 @@ std::string ShaderProgram::s_fragmentShaderSource = R"(
     out vec4 FragColor;
 
     in vec2 TexCoord;
+    in vec2 Tile;
+    flat in float Layer;
+
+    uniform sampler2DArray texture1;
 
-    uniform sampler2D texture1;
+    const vec2 tileSize = vec2(0.25, 1.0 / 3.0);
 
     void main() {
-        FragColor = texture(texture1, TexCoord);
+        // TexCoord jest w kafelkach: fract powtarza sciane na scalonych quadach,
+        // a gradient liczony bez fract nie psuje mipmap na krawedziach kafelkow
+        vec2 atlas = TexCoord * tileSize;
+        FragColor = textureGrad(texture1, vec3(Tile + fract(TexCoord) * tileSize, Layer),
+                                dFdx(atlas), dFdy(atlas));
     })";
 
 
 GLuint ShaderProgram::createShader(const GLchar *shaderSource,
                                    GLenum shaderType) {
+  TRACE_ZONE("ShaderProgram::createShader");
   const GLuint shaderId = glCreateShader(shaderType);
   if (!shaderId)
     return 0;
@@ -61,6 +91,7 @@ GLuint ShaderProgram::createShader(const GLchar *shaderSource,
 
 GLuint ShaderProgram::createProgram(GLuint vertexShader, GLuint fragmentShader,
                                     GLuint geometryShader) {
+  TRACE_ZONE("ShaderProgram::createProgram");
   programId = glCreateProgram();
   if (!programId)
     return 0;
@@ -72,9 +103,114 @@ GLuint ShaderProgram::createProgram(GLuint vertexShader, GLuint fragmentShader,
     glAttachShader(programId, geometryShader);
 
   glLinkProgram(programId);
+  reflectUniforms();
+  bindUniformBlocks();
+  modelUniform = getUniform<glm::mat4>("model");
   return programId;
 }
 
+void ShaderProgram::bindUniformBlocks() {
+  // GLSL 330 nie ma layout(binding), wiec blok kamery jest wiazany tutaj
+  const GLuint camera =
+      glGetUniformBlockIndex(programId, CameraBuffer::s_blockName);
+  if (camera != GL_INVALID_INDEX) {
+    glUniformBlockBinding(programId, camera, CameraBuffer::s_bindingPoint);
+  }
+}
+
+void ShaderProgram::reflectUniforms() {
+  uniforms.clear();
+
+  GLint count = 0;
+  GLint maxLength = 0;
+  glGetProgramiv(programId, GL_ACTIVE_UNIFORMS, &count);
+  glGetProgramiv(programId, GL_ACTIVE_UNIFORM_MAX_LENGTH, &maxLength);
+
+  std::vector<GLchar> buffer(static_cast<size_t>(maxLength) + 1);
+  for (GLint i = 0; i < count; ++i) {
+    GLsizei length = 0;
+    GLint size = 0;
+    GLenum type = 0;
+    glGetActiveUniform(programId, static_cast<GLuint>(i),
+                       static_cast<GLsizei>(buffer.size()), &length, &size,
+                       &type, buffer.data());
+    std::string name(buffer.data(), static_cast<size_t>(length));
+
+    // Tablice sa zglaszane jako "nazwa[0]"; w tabeli trzymana jest sama nazwa
+    const size_t bracket = name.find('[');
+    if (bracket != std::string::npos) {
+      name.erase(bracket);
+    }
+    const GLint location = glGetUniformLocation(programId, buffer.data());
+    // Uniformy z blokow (UBO) nie maja lokalizacji
+    if (location != -1) {
+      uniforms[name] = UniformInfo{location, type, size};
+    }
+  }
+}
+
+const ShaderProgram::UniformInfo *
+ShaderProgram::findUniform(std::string_view name) const {
+  const auto it = uniforms.find(name);
+  if (it != uniforms.end()) {
+    return &it->second;
+  }
+  if (reportedNames.find(name) == reportedNames.end()) {
+    reportedNames.emplace(name);
+    std::cerr << "Uniform '" << name << "' not found in shader program!"
+              << std::endl;
+  }
+  return nullptr;
+}
+
+namespace {
+
+// Typy GLSL, ktore mozna ustawic danym typem C++
+template <typename T> bool isCompatible(GLenum type);
+
+template <> bool isCompatible<int>(GLenum type) {
+  return type == GL_INT || type == GL_BOOL || type == GL_SAMPLER_2D ||
+         type == GL_SAMPLER_2D_ARRAY;
+}
+
+template <> bool isCompatible<glm::mat4>(GLenum type) {
+  return type == GL_FLOAT_MAT4;
+}
+
+} // namespace
+
+template <typename T>
+Uniform<T> ShaderProgram::getUniform(std::string_view name) const {
+  const UniformInfo *info = findUniform(name);
+  if (info == nullptr) {
+    return Uniform<T>();
+  }
+  if (!isCompatible<T>(info->type)) {
+    std::cerr << "Uniform '" << name << "' has a different type (0x" << std::hex
+              << info->type << std::dec << ")" << std::endl;
+    return Uniform<T>();
+  }
+  return Uniform<T>(info->location);
+}
+
+template Uniform<int> ShaderProgram::getUniform<int>(std::string_view) const;
+template Uniform<glm::mat4>
+ShaderProgram::getUniform<glm::mat4>(std::string_view) const;
+
+void ShaderProgram::set(Uniform<int> uniform, int value) {
+  if (uniform.valid()) {
+    glUniform1i(uniform.location, value);
+    RenderStats::Add(RenderStats::Counter::UniformUploads);
+  }
+}
+
+void ShaderProgram::set(Uniform<glm::mat4> uniform, const glm::mat4 &value) {
+  if (uniform.valid()) {
+    glUniformMatrix4fv(uniform.location, 1, GL_FALSE, &value[0][0]);
+    RenderStats::Add(RenderStats::Counter::UniformUploads);
+  }
+}
+
 std::pair<GLuint, GLuint> ShaderProgram::createVertexBufferObject() {
 
   const float triangle[] = {//  x          y          z
@@ -85,16 +221,16 @@ std::pair<GLuint, GLuint> ShaderProgram::createVertexBufferObject() {
   GLuint vbo, vao;
   glGenBuffers(1, &vbo);
   glGenVertexArrays(1, &vao);
-  glBindVertexArray(vao);
-  glBindBuffer(GL_ARRAY_BUFFER, vbo);
+  GLState::BindVertexArray(vao);
+  GLState::BindBuffer(GL_ARRAY_BUFFER, vbo);
   glBufferData(GL_ARRAY_BUFFER, sizeof(triangle), triangle, GL_STATIC_DRAW);
 
 
   glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 3 * sizeof(float), (void *)0);
   glEnableVertexAttribArray(0);
 
-  glBindBuffer(GL_ARRAY_BUFFER, 0);
-  glBindVertexArray(0);
+  GLState::BindBuffer(GL_ARRAY_BUFFER, 0);
+  GLState::BindVertexArray(0);
 
   return std::make_pair(vbo, vao);
 }
@@ -110,16 +246,19 @@ ShaderProgram::ShaderProgram() {
 }
 
 void ShaderProgram::cleanUp(std::pair<GLuint, GLuint> vv) {
-  glDeleteVertexArrays(1, &vv.second);
+  GLState::DeleteVertexArray(vv.second);
 
-  glDeleteBuffers(1, &vv.first);
-  glDeleteProgram(programId);
+  GLState::DeleteBuffer(vv.first);
+  GLState::DeleteProgram(programId);
   glDeleteShader(vertexShader);
   glDeleteShader(fragmentShader);
 }
 
 ShaderProgram::ShaderProgram(ShaderProgram &&rhs) noexcept
-    : programId(std::exchange(rhs.programId, 0)) {}
+    : programId(std::exchange(rhs.programId, 0)),
+      uniforms(std::move(rhs.uniforms)),
+      modelUniform(std::exchange(rhs.modelUniform, Uniform<glm::mat4>())),
+      reportedNames(std::move(rhs.reportedNames)) {}
 
 ShaderProgram &ShaderProgram::operator=(ShaderProgram &&rhs) noexcept {
 
@@ -128,33 +267,32 @@ ShaderProgram &ShaderProgram::operator=(ShaderProgram &&rhs) noexcept {
   }
 
   programId = std::exchange(rhs.programId, 0);
+  uniforms = std::move(rhs.uniforms);
+  modelUniform = std::exchange(rhs.modelUniform, Uniform<glm::mat4>());
+  reportedNames = std::move(rhs.reportedNames);
 
   return *this;
 }
 
-void ShaderProgram::use() { glUseProgram(programId); }
+void ShaderProgram::use() { GLState::UseProgram(programId); }
 
 
 void ShaderProgram::setUniform(const std::string &name,
                                const glm::mat4 &matrix) {
-  GLint location = glGetUniformLocation(programId, name.c_str());
-  if (location != -1) {
-    glUniformMatrix4fv(location, 1, GL_FALSE, &matrix[0][0]);
-  } else {
-    std::cerr << "Uniform '" << name << "' not found in shader program!"
-              << std::endl;
-  }
+  setMat4(name, matrix);
+}
 
+void ShaderProgram::setInt(const std::string_view name, int value) {
+  if (const UniformInfo *info = findUniform(name)) {
+    glUniform1i(info->location, value);
+    RenderStats::Add(RenderStats::Counter::UniformUploads);
+  }
 }
 
 void ShaderProgram::setMat4(const std::string_view name,
                             const glm::mat4 &value) {
-  GLint location = glGetUniformLocation(programId, name.data());
-  if (location != -1) {
-    glUniformMatrix4fv(location, 1, GL_FALSE, &value[0][0]);
-  } else {
-    std::cerr << "Uniform '" << name << "' not found in shader program!"
-              << std::endl;
-
+  if (const UniformInfo *info = findUniform(name)) {
+    glUniformMatrix4fv(info->location, 1, GL_FALSE, &value[0][0]);
+    RenderStats::Add(RenderStats::Counter::UniformUploads);
   }
 }
@@ -0,0 +1,120 @@
+#include "../include/Trace.hpp"
+
+#ifdef MAJNKRAFT_TRACE
+
+#include <chrono>
+#include <deque>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+// Mutex tylko przy rejestracji watku i w Collect, nigdy przy zapisie zdarzenia
+struct Trace::Registry {
+  struct Record {
+    const char *m_name;
+    int64_t m_start;
+    int64_t m_duration;
+    uint32_t m_thread;
+  };
+
+  std::mutex m_mutex;
+  std::vector<std::unique_ptr<Buffer>> m_buffers;
+  std::deque<Record> m_history;
+  size_t m_dropped{0};
+};
+
+Trace::Registry &Trace::GetRegistry() {
+  static Registry registry;
+  return registry;
+}
+
+Trace::Zone::Zone(const char *name) : m_name(name), m_start(Now()) {}
+
+Trace::Zone::~Zone() { Push({m_name, m_start, Now() - m_start}); }
+
+int64_t Trace::Now() {
+  using Clock = std::chrono::steady_clock;
+  static const Clock::time_point s_start = Clock::now();
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() -
+                                                              s_start)
+      .count();
+}
+
+Trace::Buffer &Trace::ThreadBuffer() {
+  // Bufor nalezy do rejestru, wiec przezywa swoj watek do nastepnego Collect
+  thread_local Buffer *buffer = [] {
+    Registry &registry = GetRegistry();
+    std::lock_guard<std::mutex> lock(registry.m_mutex);
+    registry.m_buffers.push_back(std::make_unique<Buffer>());
+    Buffer *created = registry.m_buffers.back().get();
+    created->m_thread = static_cast<uint32_t>(registry.m_buffers.size() - 1);
+    return created;
+  }();
+  return *buffer;
+}
+
+void Trace::Push(const Event &event) {
+  Buffer &buffer = ThreadBuffer();
+  const size_t head = buffer.m_head.load(std::memory_order_relaxed);
+  // Pelny bufor gubi nowe zdarzenia zamiast czekac na Collect
+  if (head - buffer.m_tail.load(std::memory_order_acquire) == s_bufferSize) {
+    buffer.m_dropped.fetch_add(1, std::memory_order_relaxed);
+    return;
+  }
+  buffer.m_events[head % s_bufferSize] = event;
+  buffer.m_head.store(head + 1, std::memory_order_release);
+}
+
+void Trace::Collect() {
+  Registry &registry = GetRegistry();
+  std::lock_guard<std::mutex> lock(registry.m_mutex);
+  for (const std::unique_ptr<Buffer> &pointer : registry.m_buffers) {
+    Buffer &buffer = *pointer;
+    const size_t head = buffer.m_head.load(std::memory_order_acquire);
+    size_t tail = buffer.m_tail.load(std::memory_order_relaxed);
+    for (; tail != head; ++tail) {
+      const Event &event = buffer.m_events[tail % s_bufferSize];
+      registry.m_history.push_back(
+          {event.m_name, event.m_start, event.m_duration, buffer.m_thread});
+    }
+    buffer.m_tail.store(tail, std::memory_order_release);
+    registry.m_dropped +=
+        buffer.m_dropped.exchange(0, std::memory_order_relaxed);
+  }
+
+  while (registry.m_history.size() > s_historySize) {
+    registry.m_history.pop_front();
+  }
+}
+
+bool Trace::Write(const std::string &path) {
+  Collect();
+
+  std::ofstream file(path);
+  if (!file) {
+    std::cerr << "Failed to open trace file: " << path << std::endl;
+    return false;
+  }
+
+  Registry &registry = GetRegistry();
+  std::lock_guard<std::mutex> lock(registry.m_mutex);
+  // Zdarzenia "X" (complete): ts i dur w mikrosekundach
+  file << "{\"displayTimeUnit\":\"ms\",\"droppedEvents\":" << registry.m_dropped
+       << ",\"traceEvents\":[";
+  file << std::fixed << std::setprecision(3);
+  bool first = true;
+  for (const Registry::Record &record : registry.m_history) {
+    file << (first ? "" : ",") << "\n{\"name\":\"" << record.m_name
+         << "\",\"ph\":\"X\",\"pid\":0,\"tid\":" << record.m_thread
+         << ",\"ts\":" << record.m_start / 1000.0
+         << ",\"dur\":" << record.m_duration / 1000.0 << "}";
+    first = false;
+  }
+  file << "\n]}\n";
+  return static_cast<bool>(file);
+}
+
+#endif
@@ -0,0 +1,289 @@
+#include "../include/World.hpp"
+#include "../include/Trace.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+namespace {
+// Dzielenie zaokraglane w dol, takze dla ujemnych wspolrzednych
+int FloorDivide(int value, int divisor) {
+  return value >= 0 ? value / divisor : -((-value + divisor - 1) / divisor);
+}
+} // namespace
+
+World::World(CubePalette &palette, int radius, size_t budget)
+    : m_palette(palette), m_radius(radius), m_budget(budget),
+      m_grid(2 * (radius + 1) + 1, Key(-(radius + 1), -(radius + 1))) {}
+
+World::Key World::ChunkKey(const glm::vec3 &position) {
+  return Key(static_cast<int>(std::floor(position.x / s_chunkSize)),
+             static_cast<int>(std::floor(position.z / s_chunkSize)));
+}
+
+World::Key World::ChunkKey(const glm::ivec3 &block) {
+  return Key(FloorDivide(block.x, s_chunkSize),
+             FloorDivide(block.z, s_chunkSize));
+}
+
+int World::DistanceSquared(const Key &a, const Key &b) {
+  const Key delta = a - b;
+  return delta.x * delta.x + delta.y * delta.y;
+}
+
+void World::Update(const glm::vec3 &position) {
+  TRACE_ZONE("World::Update");
+  const Key center = ChunkKey(position);
+
+  // Okno siega radius + 1: chunk'i sa usuwane dopiero za ta granica, zeby te
+  // na krawedzi promienia nie migaly
+  m_grid.MoveTo(center - Key(m_radius + 1),
+                [&](Slot &slot, const Key &from, const Key &) {
+                  Evict(slot, from);
+                });
+
+  const int keep = (m_radius + 1) * (m_radius + 1);
+  std::vector<Key> missing;
+  m_grid.ForEach([&](Slot &slot, const Key &key) {
+    const int distance = DistanceSquared(key, center);
+    if (slot.m_resident && distance > keep) {
+      Evict(slot, key);
+    } else if (!slot.m_resident && distance <= m_radius * m_radius) {
+      missing.push_back(key);
+    }
+  });
+  std::sort(missing.begin(), missing.end(), [&](const Key &a, const Key &b) {
+    return DistanceSquared(a, center) < DistanceSquared(b, center);
+  });
+
+  size_t loads = 0;
+  for (const Key &key : missing) {
+    if (loads == s_loadsPerUpdate) {
+      break;
+    }
+    // Zaparkowany chunk w slocie jest uzywany ponownie; nowy jest szacowany
+    // srednia z przydzielonych. Miejsce zwalniaja najpierw zaparkowane
+    // chunk'i, potem tylko zaladowane dalsze niz ladowany.
+    Slot &slot = m_grid.At(key);
+    const int distance = DistanceSquared(key, center);
+    while (!slot.m_chunk && m_allocated > 0 &&
+           m_memory + m_memory / m_allocated > m_budget) {
+      if (ReleaseParked(slot)) {
+        continue;
+      }
+      const Key farthest = Farthest(center);
+      if (m_resident == 0 || DistanceSquared(farthest, center) <= distance) {
+        return;
+      }
+      Slot &victim = m_grid.At(farthest);
+      Evict(victim, farthest);
+      Release(victim);
+    }
+    Load(slot, key);
+    ++loads;
+  }
+}
+
+void World::Load(Slot &slot, const Key &key) {
+  TRACE_ZONE("World::Load");
+  const glm::vec2 origin(key.x * s_chunkSize, key.y * s_chunkSize);
+  if (slot.m_chunk) {
+    m_memory -= slot.m_chunk->MemoryUsage();
+    slot.m_chunk->MoveTo(origin);
+  } else {
+    slot.m_chunk = std::make_unique<Chunk_t>(origin, m_palette);
+    ++m_allocated;
+  }
+  slot.m_chunk->Generate();
+  slot.m_chunk->SetMeshMode(m_meshMode);
+  slot.m_chunk->SetDrawPath(m_drawPath);
+  slot.m_resident = true;
+  m_memory += slot.m_chunk->MemoryUsage();
+  ++m_resident;
+  Link(*slot.m_chunk, key);
+}
+
+void World::Evict(Slot &slot, const Key &key) {
+  if (!slot.m_resident) {
+    return;
+  }
+  slot.m_resident = false;
+  --m_resident;
+  Unlink(key);
+}
+
+void World::Release(Slot &slot) {
+  if (!slot.m_chunk || slot.m_resident) {
+    return;
+  }
+  m_memory -= slot.m_chunk->MemoryUsage();
+  slot.m_chunk.reset();
+  --m_allocated;
+}
+
+bool World::ReleaseParked(const Slot &keep) {
+  Slot *parked = nullptr;
+  m_grid.ForEach([&](Slot &slot, const Key &) {
+    if (!parked && &slot != &keep && slot.m_chunk && !slot.m_resident) {
+      parked = &slot;
+    }
+  });
+  if (parked == nullptr) {
+    return false;
+  }
+  Release(*parked);
+  return true;
+}
+
+void World::Link(Chunk_t &chunk, const Key &key) {
+  for (Cube::Face side : s_sides) {
+    Chunk_t *neighbour = Neighbour(key, side);
+    chunk.SetNeighbour(side, neighbour);
+    if (neighbour != nullptr) {
+      neighbour->SetNeighbour(Cube::Opposite(side), &chunk);
+    }
+  }
+}
+
+void World::Unlink(const Key &key) {
+  for (Cube::Face side : s_sides) {
+    if (Chunk_t *neighbour = Neighbour(key, side)) {
+      neighbour->SetNeighbour(Cube::Opposite(side), nullptr);
+    }
+  }
+}
+
+World::Chunk_t *World::Neighbour(const Key &key, Cube::Face side) {
+  const glm::ivec3 direction = Cube::FaceDirection(side);
+  const Key neighbour = key + Key(direction.x, direction.z);
+  if (!m_grid.Contains(neighbour)) {
+    return nullptr;
+  }
+  Slot &slot = m_grid.At(neighbour);
+  return slot.m_resident ? slot.m_chunk.get() : nullptr;
+}
+
+World::Key World::Farthest(const Key &center) const {
+  Key farthest = center;
+  int farthestDistance = -1;
+  m_grid.ForEach([&](const Slot &slot, const Key &key) {
+    const int distance = DistanceSquared(key, center);
+    if (slot.m_resident && distance > farthestDistance) {
+      farthest = key;
+      farthestDistance = distance;
+    }
+  });
+  return farthest;
+}
+
+const World::Chunk_t *World::Find(const Key &key) const {
+  if (!m_grid.Contains(key)) {
+    return nullptr;
+  }
+  const Slot &slot = m_grid.At(key);
+  return slot.m_resident ? slot.m_chunk.get() : nullptr;
+}
+
+void World::Draw(ShaderProgram &shader) const {
+  TRACE_ZONE("World::Draw");
+  m_grid.ForEach([&](const Slot &slot, const Key &) {
+    if (slot.m_resident) {
+      slot.m_chunk->Draw(shader);
+    }
+  });
+}
+
+Ray::HitType World::Hit(const Ray &ray, Ray::time_t min, Ray::time_t max,
+                        HitRecord &record) const {
+  TRACE_ZONE("World::Hit");
+  struct Candidate {
+    Ray::time_t m_time;
+    Key m_key;
+    const Chunk_t *m_chunk;
+  };
+
+  // Chunk'i sie nie nakladaja, wiec pierwszy trafiony w kolejnosci wejscia
+  // promienia zawiera najblizsza kostke
+  std::vector<Candidate> candidates;
+  m_grid.ForEach([&](const Slot &slot, const Key &key) {
+    AABB::HitRecord bounds;
+    if (slot.m_resident &&
+        slot.m_chunk->Bounds().Hit(ray, min, max, bounds) == Ray::HitType::Hit) {
+      candidates.push_back({bounds.m_time, key, slot.m_chunk.get()});
+    }
+  });
+  std::sort(candidates.begin(), candidates.end(),
+            [](const Candidate &a, const Candidate &b) {
+              return a.m_time < b.m_time;
+            });
+
+  for (const Candidate &candidate : candidates) {
+    Chunk_t::HitRecord hit;
+    if (candidate.m_chunk->Hit(ray, min, max, hit) != Ray::HitType::Hit) {
+      continue;
+    }
+    // Indeksy chunk'a sa w kolejnosci (depth, width, height) = (z, x, y)
+    const glm::ivec3 offset(candidate.m_key.x * s_chunkSize, 0,
+                            candidate.m_key.y * s_chunkSize);
+    record.m_chunk = candidate.m_key;
+    record.m_block = offset + glm::ivec3(hit.m_cubeIndex.y, hit.m_cubeIndex.z,
+                                         hit.m_cubeIndex.x);
+    record.m_neighbour =
+        offset + glm::ivec3(hit.m_neighbourIndex.y, hit.m_neighbourIndex.z,
+                            hit.m_neighbourIndex.x);
+    return Ray::HitType::Hit;
+  }
+  return Ray::HitType::Miss;
+}
+
+bool World::RemoveBlock(const glm::ivec3 &block) {
+  if (block.y < 0 || block.y >= s_chunkSize) {
+    return false;
+  }
+  const Key key = ChunkKey(block);
+  if (!m_grid.Contains(key) || !m_grid.At(key).m_resident) {
+    return false;
+  }
+
+  Chunk_t &chunk = *m_grid.At(key).m_chunk;
+  const size_t width = static_cast<size_t>(block.x - key.x * s_chunkSize);
+  const size_t depth = static_cast<size_t>(block.z - key.y * s_chunkSize);
+  const size_t before = chunk.MemoryUsage();
+  const bool removed = chunk.RemoveBlock(static_cast<uint8_t>(width),
+                                         static_cast<uint8_t>(block.y),
+                                         static_cast<uint8_t>(depth));
+  m_memory = m_memory - before + chunk.MemoryUsage();
+
+  // Kostka na brzegu odslania sciane sasiada
+  if (removed) {
+    for (Cube::Face side : s_sides) {
+      Chunk_t *neighbour = Neighbour(key, side);
+      if (neighbour != nullptr && Chunk_t::OnBorder(side, depth, width)) {
+        const bool alongZ = side == Cube::Face::Left || side == Cube::Face::Right;
+        neighbour->UpdateBorder(Cube::Opposite(side), &chunk,
+                                alongZ ? depth : width,
+                                static_cast<size_t>(block.y));
+      }
+    }
+  }
+  return removed;
+}
+
+void World::SetMeshMode(ChunkMesh::Mode mode) {
+  m_meshMode = mode;
+  m_grid.ForEach([&](Slot &slot, const Key &) {
+    if (slot.m_chunk) {
+      slot.m_chunk->SetMeshMode(mode);
+    }
+  });
+}
+
+void World::SetDrawPath(Chunk_t::DrawPath path) {
+  m_drawPath = path;
+  m_grid.ForEach([&](Slot &slot, const Key &) {
+    if (slot.m_chunk) {
+      slot.m_chunk->SetDrawPath(path);
+    }
+  });
+}
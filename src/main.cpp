@@ -1,7 +1,14 @@
+#include "../include/Benchmark.hpp"
 #include "../include/Camera.hpp"
-#include "../include/Chunk.hpp"
+#include "../include/CameraBuffer.hpp"
+#include "../include/CameraPath.hpp"
 #include "../include/Cube.hpp"
+#include "../include/GpuProfiler.hpp"
+#include "../include/RenderBenchmark.hpp"
+#include "../include/RenderStats.hpp"
 #include "../include/ShaderProgram.hpp"
+#include "../include/Trace.hpp"
+#include "../include/World.hpp"
 #include <SFML/Window.hpp>
 #include <SFML/Window/Context.hpp>
 #include <SFML/Window/ContextSettings.hpp>
@@ -9,9 +16,28 @@
 #include <glad/glad.h>
 #include <glm/gtc/type_ptr.hpp>
 
+#include <algorithm>
 #include <iostream>
+#include <optional>
+#include <string>
+
+int main(int argc, char *argv[]) {
+  if (argc == 3 && std::string(argv[1]) == "--bench") {
+    return Benchmark::Run(argv[2]);
+  }
+  if (argc >= 2 && std::string(argv[1]) == "--render-bench") {
+    const std::optional<RenderBenchmark::Options> options = RenderBenchmark::Parse(argc, argv, 2);
+    return options ? RenderBenchmark::Run(*options) : -1;
+  }
+
+  // Plik statystyk: --stats <plik> dopisuje podsumowanie co s_window klatek,
+  // F4 dopisuje je na zadanie
+  std::string statsPath = "render_stats.jsonl";
+  if (argc == 3 && std::string(argv[1]) == "--stats") {
+    statsPath = argv[2];
+    RenderStats::WriteEvery(statsPath, RenderStats::s_window);
+  }
 
-int main() {
   sf::ContextSettings contextSettings;
   contextSettings.depthBits = 24;
   contextSettings.stencilBits = 8;
@@ -40,79 +66,180 @@ int main() {
     return -1;
   }
 
-  shaders.use();
-  shaders.setUniform("projection", camera.Projection());
+  // Widok i projekcja dla wszystkich programow, raz na klatke
+  CameraBuffer cameraBuffer;
+  GpuProfiler profiler;
+
+  // F6 nagrywa sciezke kamery dla --render-bench --path
+  CameraPath recordedPath;
+  bool recording = false;
+  float recordingTime = 0.0f;
 
   CubePalette palette;
-  const size_t chunkSize = 16;
-  Chunk<chunkSize, chunkSize, chunkSize> chunk(glm::vec2(0, 0), palette);
-  chunk.Generate(); // Wywołanie Generate bez PerlinNoise
+  // Chunk'i w promieniu 4 od kamery, do 32 MiB
+  World world(palette, 4, 32u << 20);
+  world.Update(camera.Position());
 
   sf::Clock clock;
   sf::Vector2i windowCenter(window.getSize().x / 2, window.getSize().y / 2);
   sf::Vector2i mousePosition = sf::Mouse::getPosition();
 
   while (window.isOpen()) {
+    TRACE_ZONE("main::Frame");
     const float dt = clock.restart().asSeconds();
 
-    sf::Event event;
-    while (window.pollEvent(event)) {
-      if (event.type == sf::Event::Closed) {
-        window.close();
-      } else if (event.type == sf::Event::Resized) {
-        glViewport(0, 0, event.size.width, event.size.height);
-      } else if (event.type == sf::Event::MouseButtonPressed) {
-        if (event.mouseButton.button == sf::Mouse::Left) {
-          std::cout << "Left mouse button pressed." << std::endl;
-          glm::vec3 rayOrigin = camera.Position();
-          glm::vec3 rayDirection = glm::normalize(camera.Front());
-          std::cout << "Ray origin: (" << rayOrigin.x << ", " << rayOrigin.y << ", " << rayOrigin.z << ")" << std::endl;
-          std::cout << "Ray direction: (" << rayDirection.x << ", " << rayDirection.y << ", " << rayDirection.z << ")" << std::endl;
-          Ray ray(rayOrigin, rayDirection);
-          Chunk<chunkSize, chunkSize, chunkSize>::HitRecord hitRecord;
-          if (chunk.Hit(ray, 0.0f, 100.0f, hitRecord) == Ray::HitType::Hit) {
-            std::cout << "Removing block at (" << hitRecord.m_cubeIndex.x << ", " << hitRecord.m_cubeIndex.y << ", " << hitRecord.m_cubeIndex.z << ")" << std::endl;
-            chunk.RemoveBlock(hitRecord.m_cubeIndex.x, hitRecord.m_cubeIndex.y, hitRecord.m_cubeIndex.z);
-          } else {
-            std::cout << "No block hit." << std::endl;
+    {
+      TRACE_ZONE("main::Events");
+      sf::Event event;
+      while (window.pollEvent(event)) {
+        if (event.type == sf::Event::Closed) {
+          window.close();
+        } else if (event.type == sf::Event::Resized) {
+          glViewport(0, 0, event.size.width, event.size.height);
+        } else if (event.type == sf::Event::MouseButtonPressed) {
+          if (event.mouseButton.button == sf::Mouse::Left) {
+            std::cout << "Left mouse button pressed." << std::endl;
+            glm::vec3 rayOrigin = camera.Position();
+            glm::vec3 rayDirection = glm::normalize(camera.Front());
+            std::cout << "Ray origin: (" << rayOrigin.x << ", " << rayOrigin.y << ", " << rayOrigin.z << ")" << std::endl;
+            std::cout << "Ray direction: (" << rayDirection.x << ", " << rayDirection.y << ", " << rayDirection.z << ")" << std::endl;
+            Ray ray(rayOrigin, rayDirection);
+            World::HitRecord hitRecord;
+            if (world.Hit(ray, 0.0f, 100.0f, hitRecord) == Ray::HitType::Hit) {
+              std::cout << "Removing block at (" << hitRecord.m_block.x << ", " << hitRecord.m_block.y << ", " << hitRecord.m_block.z << ")" << std::endl;
+              world.RemoveBlock(hitRecord.m_block);
+            } else {
+              std::cout << "No block hit." << std::endl;
+            }
+          }
+        } else if (event.type == sf::Event::KeyPressed && event.key.code == sf::Keyboard::G) {
+          // Przelaczanie trybu budowania geometrii chunk'ow
+          const bool greedy = world.MeshMode() == ChunkMesh::Mode::Faces;
+          world.SetMeshMode(greedy ? ChunkMesh::Mode::Greedy : ChunkMesh::Mode::Faces);
+          std::cout << "Mesh mode: " << (greedy ? "greedy" : "faces") << std::endl;
+
+          // Porownanie na chunk'u pod kamera
+          if (const World::Chunk_t *chunk = world.Find(World::ChunkKey(camera.Position()))) {
+            ChunkMesh faces;
+            ChunkMesh merged;
+            chunk->BuildMesh(faces, ChunkMesh::Mode::Faces);
+            chunk->BuildMesh(merged, ChunkMesh::Mode::Greedy);
+            std::cout << "Triangles per chunk: faces " << faces.TriangleCount() << ", greedy "
+                      << merged.TriangleCount() << " (saves " << faces.TriangleCount() - merged.TriangleCount() << ")"
+                      << std::endl;
+          }
+        } else if (event.type == sf::Event::KeyPressed && event.key.code == sf::Keyboard::F3) {
+          std::cout << "Render stats over " << std::min(RenderStats::Frames(), RenderStats::s_window) << " frames (min/avg/p99/max):" << std::endl;
+          for (size_t i = 0; i < RenderStats::s_counterCount; ++i) {
+            const RenderStats::Counter counter = static_cast<RenderStats::Counter>(i);
+            const RenderStats::Summary summary = RenderStats::Summarize(counter);
+            std::cout << "  " << RenderStats::Name(counter) << ": " << summary.m_min << " / " << summary.m_avg << " / "
+                      << summary.m_p99 << " / " << summary.m_max << std::endl;
           }
+          const GpuProfiler::Timings &timings = profiler.Latest();
+          if (timings.m_valid) {
+            std::cout << "Frame " << timings.m_frame << " (cpu / gpu ms):";
+            for (size_t i = 0; i < GpuProfiler::s_passCount; ++i) {
+              std::cout << " " << GpuProfiler::Name(static_cast<GpuProfiler::Pass>(i)) << " " << timings.m_cpu[i] << " / "
+                        << timings.m_gpu[i];
+            }
+            std::cout << ", " << (timings.GpuBound() ? "GPU" : "CPU") << "-bound, dropped " << profiler.Dropped() << std::endl;
+          }
+        } else if (event.type == sf::Event::KeyPressed && event.key.code == sf::Keyboard::F4) {
+          if (RenderStats::Write(statsPath)) {
+            std::cout << "Render stats written to " << statsPath << std::endl;
+          }
+        } else if (event.type == sf::Event::KeyPressed && event.key.code == sf::Keyboard::F6) {
+          recording = !recording;
+          if (recording) {
+            recordedPath.Clear();
+            recordingTime = 0.0f;
+            std::cout << "Recording camera path" << std::endl;
+          } else if (recordedPath.Save("camera_path.txt")) {
+            std::cout << "Camera path written to camera_path.txt" << std::endl;
+          }
+#ifdef MAJNKRAFT_TRACE
+        } else if (event.type == sf::Event::KeyPressed && event.key.code == sf::Keyboard::F5) {
+          if (Trace::Write("trace.json")) {
+            std::cout << "Trace written to trace.json" << std::endl;
+          }
+#endif
+        } else if (event.type == sf::Event::KeyPressed && event.key.code == sf::Keyboard::I) {
+          // Przelaczanie miedzy siatka chunk'a a instancjami kostek
+          using DrawPath = World::Chunk_t::DrawPath;
+          const bool instanced = world.GetDrawPath() == DrawPath::Mesh;
+          world.SetDrawPath(instanced ? DrawPath::Instanced : DrawPath::Mesh);
+          std::cout << "Draw path: " << (instanced ? "instanced" : "mesh") << std::endl;
         }
       }
     }
 
-    if (sf::Keyboard::isKeyPressed(sf::Keyboard::W)) {
-      camera.MoveForward(dt);
-    }
-    if (sf::Keyboard::isKeyPressed(sf::Keyboard::S)) {
-      camera.MoveBackward(dt);
-    }
-    if (sf::Keyboard::isKeyPressed(sf::Keyboard::A)) {
-      camera.MoveLeft(dt);
-    }
-    if (sf::Keyboard::isKeyPressed(sf::Keyboard::D)) {
-      camera.MoveRight(dt);
-    }
-    if (sf::Keyboard::isKeyPressed(sf::Keyboard::Space)) {
-      camera.MoveUp(dt);
-    }
-    if (sf::Keyboard::isKeyPressed(sf::Keyboard::LShift)) {
-      camera.MoveDown(dt);
+    {
+      TRACE_ZONE("main::Input");
+      if (sf::Keyboard::isKeyPressed(sf::Keyboard::W)) {
+        camera.MoveForward(dt);
+      }
+      if (sf::Keyboard::isKeyPressed(sf::Keyboard::S)) {
+        camera.MoveBackward(dt);
+      }
+      if (sf::Keyboard::isKeyPressed(sf::Keyboard::A)) {
+        camera.MoveLeft(dt);
+      }
+      if (sf::Keyboard::isKeyPressed(sf::Keyboard::D)) {
+        camera.MoveRight(dt);
+      }
+      if (sf::Keyboard::isKeyPressed(sf::Keyboard::Space)) {
+        camera.MoveUp(dt);
+      }
+      if (sf::Keyboard::isKeyPressed(sf::Keyboard::LShift)) {
+        camera.MoveDown(dt);
+      }
+
+      const sf::Vector2i newMousePosition = sf::Mouse::getPosition();
+      camera.Rotate(newMousePosition - mousePosition);
+      mousePosition = newMousePosition;
+
+      if (recording) {
+        recordedPath.Add(recordingTime, camera);
+        recordingTime += dt;
+      }
     }
 
-    const sf::Vector2i newMousePosition = sf::Mouse::getPosition();
-    camera.Rotate(newMousePosition - mousePosition);
-    mousePosition = newMousePosition;
+    world.Update(camera.Position());
+
+    profiler.BeginFrame();
+
+    {
+      TRACE_ZONE("main::Clear");
+      profiler.Begin(GpuProfiler::Pass::Clear);
+      glClearColor(0.2f, 0.3f, 0.3f, 1.0f);
+      glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+      profiler.End(GpuProfiler::Pass::Clear);
+    }
 
-    glClearColor(0.2f, 0.3f, 0.3f, 1.0f);
-    glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+    {
+      TRACE_ZONE("main::Draw");
+      profiler.Begin(GpuProfiler::Pass::Draw);
+      cameraBuffer.Update(camera);
 
-    shaders.setUniform("view", camera.View());
-    shaders.setUniform("projection", camera.Projection());
+      world.Draw(shaders);
+      profiler.End(GpuProfiler::Pass::Draw);
+    }
 
-    chunk.Draw(shaders);
+    {
+      TRACE_ZONE("main::Present");
+      profiler.Begin(GpuProfiler::Pass::Present);
+      window.display();
+      profiler.End(GpuProfiler::Pass::Present);
+    }
 
-    window.display();
+    profiler.EndFrame();
+    RenderStats::EndFrame(dt * 1000.0);
+    TRACE_COLLECT();
   }
 
+  // Przy wlaczonym sledzeniu ostatnie klatki zostaja w pliku po zamknieciu
+  TRACE_WRITE("trace.json");
+
   return 0;
 }
\ No newline at end of file